@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include "MyUtils.h"
+#include "FitnessHistory.h"
+
+
+inline constexpr uint32_t CHECKPOINT_MAGIC   = 0x4B434753; // "SGCK"
+inline constexpr uint32_t CHECKPOINT_VERSION = 4;
+
+class CheckpointData {
+public:
+	std::vector<uint8_t> genes; // populationSize * gridSize * gridSize traits, individual after individual
+	std::vector<int32_t> fitness;
+	std::vector<FitnessSample> history;
+	std::string fitnessFuncName; // By name, plugins are ordered by file name and may change between runs
+	uint64_t seed          = 0;
+	uint64_t traceChecksum = 0;
+	uint64_t historyArchiveSize = 0;
+	uint64_t historyBucketWidth = 1;
+	uint64_t historyTotalSize   = 0;
+	int64_t generation    = 0;
+	int gridSize          = 0;
+	int populationSize    = 0;
+	int mutationRate      = 0;
+	int randomGenesRate   = 0;
+	int eliteSurvivalRate = 0;
+	int runTimeMs         = 0;
+	int crossoverType     = 0;
+	int steadyStateChildAmount = 0; // 0 for a generational run
+	bool shouldReplaceDuplicates = false;
+};
+
+class Checkpoint {
+public:
+	static bool save(const std::string& path, const CheckpointData& data);
+	[[nodiscard]] static std::optional<CheckpointData> load(const std::string& path);
+
+private:
+	class Header {
+	public:
+		uint32_t magic   = CHECKPOINT_MAGIC;
+		uint32_t version = CHECKPOINT_VERSION;
+		int32_t gridSize          = 0;
+		int32_t populationSize    = 0;
+		int32_t mutationRate      = 0;
+		int32_t randomGenesRate   = 0;
+		int32_t eliteSurvivalRate = 0;
+		int32_t shouldReplaceDuplicates = 0;
+		int32_t runTimeMs         = 0;
+		int32_t crossoverType     = 0;
+		int32_t steadyStateChildAmount = 0;
+		int64_t generation          = 0;
+		uint64_t historySize        = 0;
+		uint64_t fitnessFuncNameSize = 0;
+		uint64_t historyArchiveSize = 0;
+		uint64_t historyBucketWidth = 0;
+		uint64_t historyTotalSize   = 0;
+		uint64_t seed               = 0;
+		uint64_t traceChecksum      = 0;
+	};
+
+	[[nodiscard]] static uint64_t getGeneAmount(const Header& header) noexcept;
+	[[nodiscard]] static uint64_t getFileSize(const Header& header) noexcept;
+	[[nodiscard]] static std::optional<CheckpointData> parse(const char* bytes, size_t byteAmount, const std::string& path);
+};
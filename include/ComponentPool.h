@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "MyUtils.h"
+
+
+inline constexpr uint32_t INVALID_DENSE_INDEX = std::numeric_limits<uint32_t>::max();
+
+// Sparse set of one component type. Components are packed in insertion order in a dense array, and the sparse array
+// maps an entity index to its component. Removal swaps the last component into the gap, so the dense array never has holes.
+// Adding a component may reallocate the dense array, which invalidates references to other components of this type.
+template <typename T>
+class ComponentPool {
+public:
+	[[nodiscard]] bool contains(uint32_t entityIndex) const noexcept {
+		return entityIndex < m_sparse.size() && m_sparse[entityIndex] != INVALID_DENSE_INDEX;
+	}
+
+
+	[[nodiscard]] const T& get(uint32_t entityIndex) const noexcept {
+		INPUT_VALIDITY(contains(entityIndex));
+
+		return m_dense[m_sparse[entityIndex]];
+	}
+
+
+	[[nodiscard]] T& get(uint32_t entityIndex) noexcept {
+		INPUT_VALIDITY(contains(entityIndex));
+
+		return m_dense[m_sparse[entityIndex]];
+	}
+
+
+	template <typename... Args>
+	T& emplace(uint32_t entityIndex, Args&&... args) {
+		if (contains(entityIndex)) {
+			T& component = m_dense[m_sparse[entityIndex]];
+			component = T(std::forward<Args>(args)...);
+			return component;
+		}
+
+		if (entityIndex >= m_sparse.size()) {
+			m_sparse.resize(static_cast<size_t>(entityIndex) + 1, INVALID_DENSE_INDEX);
+		}
+		m_sparse[entityIndex] = static_cast<uint32_t>(m_dense.size());
+		m_denseEntities.emplace_back(entityIndex);
+		return m_dense.emplace_back(std::forward<Args>(args)...);
+	}
+
+
+	void remove(uint32_t entityIndex) noexcept {
+		if (!contains(entityIndex)) {
+			return;
+		}
+
+		uint32_t denseIndex = m_sparse[entityIndex];
+		// The last component is only popped, moving it onto itself is not safe for SFML members
+		if (denseIndex != m_dense.size() - 1) {
+			uint32_t lastEntityIndex = m_denseEntities.back();
+			m_dense[denseIndex] = std::move(m_dense.back());
+			m_denseEntities[denseIndex] = lastEntityIndex;
+			m_sparse[lastEntityIndex] = denseIndex;
+		}
+		m_sparse[entityIndex] = INVALID_DENSE_INDEX;
+
+		m_dense.pop_back();
+		m_denseEntities.pop_back();
+	}
+
+
+	void reserve(size_t entityAmount) {
+		m_dense.reserve(entityAmount);
+		m_denseEntities.reserve(entityAmount);
+		m_sparse.reserve(entityAmount);
+	}
+
+
+	[[nodiscard]] size_t size() const noexcept {
+		return m_dense.size();
+	}
+
+
+	[[nodiscard]] const std::vector<uint32_t>& getEntityIndices() const noexcept {
+		return m_denseEntities;
+	}
+
+
+private:
+	std::vector<T> m_dense;
+	std::vector<uint32_t> m_denseEntities; // Entity index of each dense component
+	std::vector<uint32_t> m_sparse;        // Dense index of each entity index, INVALID_DENSE_INDEX when absent
+};
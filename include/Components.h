@@ -3,10 +3,8 @@
 #include "MyUtils.h"
 
 
-class ComponentBase {
-public:
-	bool has = false;
-};
+// Components live in sparse sets, so whether an entity has one is answered by its pool instead of a flag
+class ComponentBase {};
 
 
 class CTransform : public ComponentBase {
@@ -8,7 +8,8 @@ public:
 	explicit Entity(EntityId_t entityId) noexcept;
 
 	[[nodiscard]] EntityId_t getId() const noexcept;
-	[[nodiscard]] const std::string& getTag() const noexcept;
+	[[nodiscard]] TagId_t getTag() const noexcept;
+	[[nodiscard]] const std::string& getTagName() const noexcept;
 	[[nodiscard]] bool isAlive() const noexcept;
 	void destroy() const noexcept;
 
@@ -44,5 +45,8 @@ public:
 
 
 private:
-	EntityId_t m_id = std::numeric_limits<EntityId_t>::max();
+	EntityId_t m_id = INVALID_ENTITY_ID;
 };
+
+// Included after Entity is complete, EntityView constructs entities
+#include "EntityView.h"
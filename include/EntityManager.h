@@ -1,24 +1,35 @@
 #pragma once
 #include <unordered_map>
 #include <ranges>
+#include <algorithm>
 #include "Entity.h"
+#include "EntityView.h"
 
 
 class EntityManager {
 public:
 	void update();
+	Entity addEntity(TagId_t tag);
 	Entity addEntity(const std::string& tag);
 	[[nodiscard]] const std::vector<Entity>& getEntities() const noexcept;
 	[[nodiscard]] std::vector<Entity>& getEntities() noexcept;
+	[[nodiscard]] const std::vector<Entity>& getEntities(TagId_t tag) const noexcept;
 	[[nodiscard]] const std::vector<Entity>& getEntities(const std::string& tag) const;
-	[[nodiscard]] std::vector<Entity>& getEntities(const std::string& tag);
+
+
+	template <typename... Ts>
+	[[nodiscard]] EntityView<Ts...> view() noexcept {
+		return EntityMemoryPool::Instance().view<Ts...>();
+	}
+
 
 private:
 	std::vector<Entity> m_entities;
 	std::vector<Entity> m_entitiesToAdd;
-	std::unordered_map<std::string, std::vector<Entity>> m_entityMap;
+	std::vector<std::vector<Entity>> m_entitiesByTag; // Indexed by tag id, unordered because removal swaps in the last entity
+	std::vector<uint32_t> m_tagListPositions;         // Position of each entity index in its tag list
 
 	void addEntities();
 	void removeEntities();
-	void removeFromEntityMap(Entity entity);
+	void removeFromTagList(Entity entity);
 };
@@ -1,99 +1,162 @@
 #pragma once
 #include <tuple>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <optional>
 #include <iostream>
 #include <cstdint>
 #include <limits>
 #include "Components.h"
+#include "ComponentPool.h"
 
 
-using EntityId_t = uint8_t;
+// The low bits of an id index the entity slot, the high bits count how often that slot was reused.
+// A handle to a destroyed entity keeps its old generation, so it no longer matches the slot.
+using EntityId_t = uint32_t;
 
-inline EntityId_t ENTITY_MEMORY_POOL_MAX_SIZE = 1;
+inline constexpr uint32_t ENTITY_INDEX_BITS      = 20;
+inline constexpr uint32_t ENTITY_INDEX_MASK      = (1u << ENTITY_INDEX_BITS) - 1;
+inline constexpr uint32_t ENTITY_GENERATION_MASK = (1u << (32 - ENTITY_INDEX_BITS)) - 1;
+inline constexpr size_t ENTITY_MAX_AMOUNT        = ENTITY_INDEX_MASK; // The all-ones index is left to INVALID_ENTITY_ID
+inline constexpr EntityId_t INVALID_ENTITY_ID    = std::numeric_limits<EntityId_t>::max();
+
+// Tags are interned once by registerTag, entities and per-tag lists only carry the small id
+using TagId_t = uint16_t;
+
+inline constexpr TagId_t INVALID_TAG_ID = std::numeric_limits<TagId_t>::max();
+
+inline constexpr size_t ENTITY_MEMORY_POOL_INITIAL_CAPACITY = 1'024;
 
 class EntityManager;
 class Entity;
 
+template <typename... Ts>
+class EntityView;
+
 
 class EntityMemoryPool {
 	using ComponentsTuple_t = std::tuple<
-		std::vector<CTransform>,
-		std::vector<CAnimation>,
-		std::vector<CShape>,
-		std::vector<CText>
+		ComponentPool<CTransform>,
+		ComponentPool<CAnimation>,
+		ComponentPool<CShape>,
+		ComponentPool<CText>
 	>;
 
 	friend EntityManager;
 
+	template <typename... Ts>
+	friend class EntityView;
+
 public:
 	[[nodiscard]] static EntityMemoryPool& Instance();
 
-	[[nodiscard]] const std::string& getTag(EntityId_t entityId) const noexcept;
+	TagId_t registerTag(const std::string& name);
+	[[nodiscard]] std::optional<TagId_t> findTag(const std::string& name) const;
+	[[nodiscard]] const std::string& getTagName(TagId_t tag) const noexcept;
+	[[nodiscard]] size_t getTagAmount() const noexcept;
+
+	[[nodiscard]] TagId_t getTag(EntityId_t entityId) const noexcept;
 	[[nodiscard]] bool isAlive(EntityId_t entityId) const noexcept;
+	[[nodiscard]] bool isValid(EntityId_t entityId) const noexcept;
 	void destroy(EntityId_t entityId) noexcept;
+	void reserve(size_t entityAmount);
+	[[nodiscard]] size_t getAliveAmount() const noexcept;
+
+	[[nodiscard]] static constexpr uint32_t getIndex(EntityId_t entityId) noexcept {
+		return entityId & ENTITY_INDEX_MASK;
+	}
+
+	[[nodiscard]] static constexpr uint32_t getGeneration(EntityId_t entityId) noexcept {
+		return entityId >> ENTITY_INDEX_BITS;
+	}
+
+	[[nodiscard]] static constexpr EntityId_t makeId(uint32_t index, uint32_t generation) noexcept {
+		return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+	}
 
 
 	template <typename T>
 	[[nodiscard]] const T& getComponent(EntityId_t entityId) const {
-		return std::get<std::vector<T>>(m_data)[entityId];
+		INPUT_VALIDITY(isValid(entityId));
+
+		return std::get<ComponentPool<T>>(m_data).get(getIndex(entityId));
 	}
 
 
 	template <typename T>
 	[[nodiscard]] T& getComponent(EntityId_t entityId) {
-		return std::get<std::vector<T>>(m_data)[entityId];
+		INPUT_VALIDITY(isValid(entityId));
+
+		return std::get<ComponentPool<T>>(m_data).get(getIndex(entityId));
 	}
 
 
 	template <typename T>
 	[[nodiscard]] bool hasComponent(EntityId_t entityId) const {
-		return getComponent<T>(entityId).has;
+		return isValid(entityId) && std::get<ComponentPool<T>>(m_data).contains(getIndex(entityId));
 	}
 
 
 	template <typename T, typename... Args>
 	T& addComponent(EntityId_t entityId, Args&&... args) {
-		auto& component = getComponent<T>(entityId);
-		component = T(std::forward<Args>(args)...);
-		component.has = true;
-		return component;
+		INPUT_VALIDITY(isValid(entityId));
+
+		return std::get<ComponentPool<T>>(m_data).emplace(getIndex(entityId), std::forward<Args>(args)...);
 	}
 
 
 	template <typename T>
 	void removeComponent(EntityId_t entityId) {
-		getComponent<T>(entityId).has = false;
+		INPUT_VALIDITY(isValid(entityId));
+
+		std::get<ComponentPool<T>>(m_data).remove(getIndex(entityId));
 	}
 
 
+	// Defined with EntityView in EntityView.h, which Entity.h includes at its end
+	template <typename... Ts>
+	[[nodiscard]] EntityView<Ts...> view() noexcept;
+
+
 private:
+	class Slot {
+	public:
+		uint32_t generation = 0;
+		bool isAlive = false;
+	};
+
 	ComponentsTuple_t m_data;
-	std::vector<std::string> m_tags;
-	std::vector<bool> m_alive;
-	EntityId_t m_nextEntityId = 0;
-	EntityId_t m_poolSize;
+	std::vector<std::string> m_tagNames;
+	std::unordered_map<std::string, TagId_t> m_tagIds;
+	std::vector<TagId_t> m_tags;
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_freeIndices; // Released slots, reused last in first out
+	size_t m_aliveAmount = 0;
 
-	explicit EntityMemoryPool(EntityId_t poolSize);
+	explicit EntityMemoryPool(size_t initialCapacity);
 
-	[[nodiscard]] Entity addEntity(const std::string& tag);
-	[[nodiscard]] EntityId_t getFreeIndexFromBack() const noexcept;
-	[[nodiscard]] EntityId_t getFreeIndexFromFront() const noexcept;
-	[[nodiscard]] bool isPoolFull() const noexcept;
+	[[nodiscard]] Entity addEntity(TagId_t tag);
+	void release(EntityId_t entityId);
 
 
-	template<uint8_t I = 0>
-	void initTuple() {
-		if constexpr (I < std::tuple_size<ComponentsTuple_t>::value) {
-			std::get<I>(m_data).resize(m_poolSize);
-			initTuple<I + 1>();
+	template<size_t I = 0>
+	void reserveComponents(size_t entityAmount) {
+		if constexpr (I < std::tuple_size_v<ComponentsTuple_t>) {
+			std::get<I>(m_data).reserve(entityAmount);
+			reserveComponents<I + 1>(entityAmount);
 		}
 	}
 
 
-	template<uint8_t I = 0>
-	void resetComponents(EntityId_t entityId) {
-		if constexpr (I < std::tuple_size<ComponentsTuple_t>::value) {
-			std::get<I>(m_data)[entityId] = {};
-			resetComponents<I + 1>(entityId);
+	template<size_t I = 0>
+	void removeComponents(uint32_t entityIndex) noexcept {
+		if constexpr (I < std::tuple_size_v<ComponentsTuple_t>) {
+			std::get<I>(m_data).remove(entityIndex);
+			removeComponents<I + 1>(entityIndex);
 		}
 	}
 };
+
+// Completes Entity and EntityView, so view() can be called with only this header included
+#include "Entity.h"
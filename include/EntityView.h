@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "Entity.h"
+#include "WorkerPool.h"
+
+
+inline constexpr size_t ENTITY_VIEW_MIN_CHUNK_SIZE = 1'024; // Smaller views are not worth a thread
+
+// Alive entities that have every component in Ts. Iteration walks the packed entity list of the smallest of the
+// component pools in order and looks the other components up through their sparse arrays.
+// Adding or removing components of the viewed types while iterating invalidates the view.
+template <typename... Ts>
+class EntityView {
+	static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+public:
+	explicit EntityView(EntityMemoryPool& pool) noexcept
+		: m_pool{ &pool }
+		, m_leadEntityIndices{ &getSmallestEntityIndices(pool) } {}
+
+
+	// Calls func(Entity, Ts&...) for every matching entity
+	template <typename Func>
+	void each(Func&& func) const {
+		eachInRange(func, 0, m_leadEntityIndices->size());
+	}
+
+
+	// Splits the view into chunks of at least minChunkSize entities, func runs concurrently on different entities.
+	// The chunks run on WorkerPool::Instance() and the calling thread.
+	template <typename Func>
+	void parallelEach(Func&& func, size_t minChunkSize = ENTITY_VIEW_MIN_CHUNK_SIZE) const {
+		INPUT_VALIDITY(minChunkSize > 0);
+
+		WorkerPool& workerPool = WorkerPool::Instance();
+		size_t size = m_leadEntityIndices->size();
+		size_t chunkAmount = std::clamp<size_t>(size / minChunkSize, 1, workerPool.getThreadAmount() + 1);
+		size_t chunkSize = (size + chunkAmount - 1) / chunkAmount;
+
+		workerPool.run(chunkAmount, [this, &func, size, chunkSize](size_t chunkIndex) {
+			eachInRange(func, chunkIndex * chunkSize, std::min(size, (chunkIndex + 1) * chunkSize));
+		});
+	}
+
+
+	// Upper bound of the matching entities, exact for a single component type
+	[[nodiscard]] size_t sizeHint() const noexcept {
+		return m_leadEntityIndices->size();
+	}
+
+
+private:
+	EntityMemoryPool* m_pool = nullptr;
+	const std::vector<uint32_t>* m_leadEntityIndices = nullptr;
+
+
+	template <typename Func>
+	void eachInRange(Func& func, size_t begin, size_t end) const {
+		for (size_t i = begin; i < end; i++) {
+			uint32_t entityIndex = (*m_leadEntityIndices)[i];
+			const EntityMemoryPool::Slot& slot = m_pool->m_slots[entityIndex];
+			if (!slot.isAlive || !(std::get<ComponentPool<Ts>>(m_pool->m_data).contains(entityIndex) && ...)) {
+				continue;
+			}
+
+			func(Entity(EntityMemoryPool::makeId(entityIndex, slot.generation)), std::get<ComponentPool<Ts>>(m_pool->m_data).get(entityIndex)...);
+		}
+	}
+
+
+	[[nodiscard]] static const std::vector<uint32_t>& getSmallestEntityIndices(EntityMemoryPool& pool) noexcept {
+		const std::vector<uint32_t>* result = nullptr;
+		auto pickSmaller = [&result](const std::vector<uint32_t>& entityIndices) {
+			if (result == nullptr || entityIndices.size() < result->size()) {
+				result = &entityIndices;
+			}
+		};
+		(pickSmaller(std::get<ComponentPool<Ts>>(pool.m_data).getEntityIndices()), ...);
+
+		return *result;
+	}
+};
+
+
+template <typename... Ts>
+EntityView<Ts...> EntityMemoryPool::view() noexcept {
+	return EntityView<Ts...>(*this);
+}
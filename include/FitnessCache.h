@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <cstdint>
+#include "MyUtils.h"
+
+
+inline constexpr size_t FITNESS_CACHE_SHARD_AMOUNT = 16;
+
+class FitnessCache {
+public:
+	explicit FitnessCache(size_t capacity);
+
+	[[nodiscard]] std::optional<int> find(uint64_t hash) const;
+	void insert(uint64_t hash, int fitness);
+	void clear();
+
+private:
+	class Entry {
+	public:
+		uint64_t hash = 0;
+		int fitness = 0;
+		bool isUsed = false;
+	};
+
+	class Shard {
+	public:
+		mutable std::mutex mutex;
+		std::vector<Entry> entries;
+	};
+
+	std::array<Shard, FITNESS_CACHE_SHARD_AMOUNT> m_shards;
+	size_t m_shardCapacity = 1;
+
+	[[nodiscard]] const Shard& getShard(uint64_t hash) const noexcept;
+	[[nodiscard]] Shard& getShard(uint64_t hash) noexcept;
+	[[nodiscard]] size_t getSlotIndex(uint64_t hash) const noexcept;
+};
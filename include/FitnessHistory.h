@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "MyUtils.h"
+
+
+class FitnessSample {
+public:
+	double generation = 0;
+	double maxFitness = 0;
+	double minFitness = 0;
+	double avgFitnessSum = 0;
+	size_t sampleAmount = 0;
+};
+
+
+class FitnessPlotData {
+public:
+	std::vector<double> generations;
+	std::vector<double> maxValues;
+	std::vector<double> minValues;
+	std::vector<double> avgValues;
+};
+
+
+class FitnessHistory {
+public:
+	explicit FitnessHistory(size_t recentCapacity, size_t archiveCapacity);
+
+	void add(int64_t generation, int maxFitness, int minFitness, int avgFitness);
+	void clear() noexcept;
+	[[nodiscard]] size_t size() const noexcept;
+	[[nodiscard]] const FitnessPlotData& getPlotData();
+	[[nodiscard]] std::vector<FitnessSample> getSamples() const;
+	[[nodiscard]] size_t getArchiveSize() const noexcept;
+	[[nodiscard]] size_t getBucketWidth() const noexcept;
+	bool restore(const FitnessSample* samples, size_t sampleAmount, size_t archiveSize, size_t bucketWidth, size_t totalSize);
+
+private:
+	using Sample = FitnessSample;
+
+	std::vector<Sample> m_recent;
+	std::vector<Sample> m_archive;
+	FitnessPlotData m_plotData;
+	size_t m_recentStart = 0;
+	size_t m_recentSize = 0;
+	size_t m_archiveCapacity = 0;
+	size_t m_bucketWidth = 1;
+	size_t m_totalSize = 0;
+	bool m_isPlotDataDirty = true;
+
+	void archive(const Sample& sample);
+	void compactArchive();
+	[[nodiscard]] static Sample mergeSamples(const Sample& sample1, const Sample& sample2) noexcept;
+	void appendPlotPoint(const Sample& sample);
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <span>
+#include "Individual.h"
+#include "FitnessPluginApi.h"
+
+
+class FitnessPlugin {
+public:
+	FitnessPlugin(const FitnessPlugin&) = delete;
+	FitnessPlugin& operator=(const FitnessPlugin&) = delete;
+	~FitnessPlugin();
+
+	[[nodiscard]] static std::shared_ptr<FitnessPlugin> load(const std::string& path);
+	[[nodiscard]] static std::vector<std::shared_ptr<FitnessPlugin>> loadDirectory(const std::string& directory);
+
+	void evaluate(std::span<const Individual* const> individuals, std::span<int> fitness) const;
+	[[nodiscard]] Gene_t color(const Individual& individual) const;
+	[[nodiscard]] int getOptimalFitness(int gridSize) const;
+	[[nodiscard]] bool hasColorFunc() const noexcept;
+	[[nodiscard]] const std::string& getName() const noexcept;
+
+private:
+	void* m_handle = nullptr;
+	std::string m_name;
+	GaPluginFitnessBatchFunc m_fitnessBatchFunc = nullptr;
+	GaPluginOptimalFitnessFunc m_optimalFitnessFunc = nullptr;
+	GaPluginColorFunc m_colorFunc = nullptr;
+
+	FitnessPlugin() = default;
+
+	[[nodiscard]] void* getSymbol(const char* name) const noexcept;
+};
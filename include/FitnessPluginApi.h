@@ -0,0 +1,41 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// C interface of fitness plugins. A plugin is a shared library (.so, or .dll on Windows) placed in the plugin directory
+// named in resources/config.txt. Genes are gridSize * gridSize traits in 0..gridSize - 1, stored row after row.
+//
+// Required exports:
+//   uint32_t ga_plugin_api_version(void)  returns GA_PLUGIN_API_VERSION
+//   const char* ga_plugin_name(void)      name shown in the fitness function combo
+//   void ga_fitness_batch(const uint8_t* genes, size_t genomeAmount, int32_t gridSize, int32_t* fitness)
+//                                         scores genomeAmount genes laid out back to back, fitness must be non-negative
+//   int32_t ga_optimal_fitness(int32_t gridSize)
+//                                         fitness at which a run counts as solved
+// Optional export:
+//   void ga_color(const uint8_t* gene, int32_t gridSize, uint8_t* colors)
+//                                         writes one value in 0..gridSize per trait, higher values are drawn redder
+//
+// ga_fitness_batch is called from several threads at once and must not keep state between calls.
+
+#define GA_PLUGIN_API_VERSION 1
+
+#ifdef _WIN32
+#define GA_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define GA_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t (*GaPluginApiVersionFunc)(void);
+typedef const char* (*GaPluginNameFunc)(void);
+typedef void (*GaPluginFitnessBatchFunc)(const uint8_t* genes, size_t genomeAmount, int32_t gridSize, int32_t* fitness);
+typedef int32_t (*GaPluginOptimalFitnessFunc)(int32_t gridSize);
+typedef void (*GaPluginColorFunc)(const uint8_t* gene, int32_t gridSize, uint8_t* colors);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 #include "Scene.h"
 #include "Assets.h"
+#include "Tracer.h"
 #include "imgui.h"
 #include "imgui-SFML.h"
 #include "implot.h"
@@ -8,7 +9,7 @@
 
 class GameEngine {
 public:
-	explicit GameEngine(const std::string& configPath);
+	explicit GameEngine(const std::string& configPath, std::vector<std::string> configOverrides = {});
 	~GameEngine();
 
 	void changeScene(SceneType sceneType, std::unique_ptr<Scene> scene, bool endCurScene) noexcept;
@@ -20,12 +21,14 @@ public:
 	[[nodiscard]] int getFramerateLimit() const noexcept;
 	[[nodiscard]] const Assets& assets() const noexcept;
 	[[nodiscard]] const std::string& getConfigPath() const noexcept;
+	[[nodiscard]] std::vector<std::string> readConfigLines() const;
 
 private:
 	sf::RenderWindow m_window;
 	Assets m_assets;
 	std::unordered_map<SceneType, std::unique_ptr<Scene>> m_sceneMap;
 	std::string m_configPath = "NONE";
+	std::vector<std::string> m_configOverrides;
 	sf::Vector2u m_minWindowSize = { 120u, 120u };
 	int m_framerateLimit = 60;
 	SceneType m_currentSceneType = SceneType::None;
@@ -0,0 +1,33 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include "MyUtils.h"
+
+
+// Bump allocator for the temporaries of one generation on one worker thread. Deallocation is a no-op and reset()
+// rewinds the block in O(1). Requests that do not fit go to overflow blocks, which reset() folds into one bigger block,
+// so after the first generations every generation runs without touching the global allocator.
+class GenerationArena : public std::pmr::memory_resource {
+public:
+	explicit GenerationArena(size_t capacity = 1 << 16);
+	GenerationArena(const GenerationArena&) = delete;
+	GenerationArena& operator=(const GenerationArena&) = delete;
+
+	void reset() noexcept;
+	[[nodiscard]] size_t getCapacity() const noexcept;
+	[[nodiscard]] size_t getUsedBytes() const noexcept;
+	[[nodiscard]] size_t getOverflowAmount() const noexcept;
+
+private:
+	std::unique_ptr<std::byte[]> m_block;
+	std::vector<std::unique_ptr<std::byte[]>> m_overflowBlocks;
+	size_t m_capacity = 0;
+	size_t m_offset = 0;
+	size_t m_overflowSize = 0;
+
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	void do_deallocate(void* pointer, size_t bytes, size_t alignment) noexcept override;
+	[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cmath>
+#include "MyUtils.h"
+#include "Individual.h"
+
+
+inline constexpr int GLYPH_ATLAS_SLOT_SIZE = 64;
+inline constexpr float MIN_GLYPH_CELL_SIZE = 10.f;
+
+class GridRenderer {
+public:
+	explicit GridRenderer(const sf::Font& font);
+
+	void resize(int gridSize, float gridPhysicalSize);
+	void update(const Gene_t& traits, const Gene_t& colorTraits, float colorShare);
+	void draw(sf::RenderTarget& target) const;
+
+private:
+	sf::VertexArray m_cellQuads   = sf::VertexArray(sf::Quads);
+	sf::VertexArray m_glyphQuads  = sf::VertexArray(sf::Quads);
+	sf::VertexArray m_boxLines    = sf::VertexArray(sf::Lines);
+	sf::RenderTexture m_glyphAtlas;
+	std::vector<int> m_shownTraits;
+	std::vector<int> m_shownColors;
+	const sf::Font* m_font = nullptr;
+	float m_gridPhysicalSize = 0;
+	int m_gridSize = 0;
+	int m_atlasColumns = 1;
+	bool m_shouldDrawGlyphs = true;
+
+	void buildGlyphAtlas();
+	void buildCells();
+	void buildBoxLines();
+	[[nodiscard]] sf::FloatRect getGlyphRect(int trait) const noexcept;
+	static void setQuad(sf::VertexArray& quads, size_t quadIndex, sf::FloatRect rect) noexcept;
+	static void setQuadColor(sf::VertexArray& quads, size_t quadIndex, sf::Color color) noexcept;
+	static void setQuadTexCoords(sf::VertexArray& quads, size_t quadIndex, sf::FloatRect rect) noexcept;
+};
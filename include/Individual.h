@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <bitset>
+#include <array>
+#include <cstdint>
+#include "MyUtils.h"
+
+
+inline constexpr int MAX_BOX_SIZE  = 10;
+inline constexpr int MAX_GRID_SIZE = MAX_BOX_SIZE * MAX_BOX_SIZE;
+
+using Trait_t    = uint8_t;
+using Gene_t     = std::vector<Trait_t>;
+using TraitSet_t = std::bitset<MAX_GRID_SIZE>;
+
+static_assert(MAX_GRID_SIZE <= 256, "Traits 0..MAX_GRID_SIZE - 1 must fit in Trait_t");
+static_assert(sizeof(Trait_t) == 1, "Uniform crossover blends eight traits per 64-bit word");
+
+enum class CrossoverType : uint8_t {
+	SinglePoint = 0,
+	Uniform,
+	TwoPoint,
+	RowBlock,
+	BoxBlock
+};
+
+inline constexpr int CROSSOVER_TYPE_AMOUNT = 5;
+inline constexpr std::array<const char*, CROSSOVER_TYPE_AMOUNT> CROSSOVER_NAMES = { "Single point", "Uniform", "Two point", "Row block", "Box block" };
+
+// Bit i of the index selects byte i of the mask, so 8 random bits pick 8 traits of a 64-bit word at once
+inline constexpr std::array<uint64_t, 256> BYTE_MASKS = [] {
+	std::array<uint64_t, 256> result = {};
+	for (size_t bits = 0; bits < result.size(); bits++) {
+		for (size_t byte = 0; byte < 8; byte++) {
+			if ((bits >> byte) & 1) {
+				result[bits] |= 0xFFULL << (byte * 8);
+			}
+		}
+	}
+	return result;
+}();
+
+class Individual {
+public:
+	Gene_t gene;
+	uint64_t hash = 0;
+	int fitness = 0;
+	bool isFitnessValid = false;
+
+	Individual() {}
+
+	Individual(Gene_t&& genePrm)
+		: gene(std::move(genePrm))
+		, hash(computeHash(this->gene)) {
+
+		INPUT_VALIDITY(!this->gene.empty());
+	}
+
+	bool setTrait(size_t index, Trait_t trait) noexcept {
+		INPUT_VALIDITY(index < gene.size());
+
+		if (gene[index] == trait) {
+			return false;
+		}
+
+		hash ^= traitHash(index, gene[index]) ^ traitHash(index, trait);
+		gene[index] = trait;
+		isFitnessValid = false;
+		return true;
+	}
+
+	[[nodiscard]] static uint64_t traitHash(size_t index, Trait_t trait) noexcept {
+		return MyUtils::mixHash((static_cast<uint64_t>(index) << 32) | trait);
+	}
+
+	[[nodiscard]] static uint64_t computeHash(const Gene_t& gene) noexcept {
+		uint64_t result = 0;
+		for (size_t i = 0; i < gene.size(); i++) {
+			result ^= traitHash(i, gene[i]);
+		}
+		return result;
+	}
+};
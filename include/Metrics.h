@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <stop_token>
+#include <atomic>
+#include <cstdint>
+#include "MyUtils.h"
+
+
+inline constexpr int METRICS_POLL_INTERVAL_MS = 200;
+inline constexpr size_t METRICS_MAX_REQUEST_SIZE = 4'096;
+
+// Counters and gauges of the running GA. Writers only do relaxed loads and stores, so recording a generation costs
+// a few uncontended atomic adds. Values read together during a scrape may come from neighbouring generations.
+class GaMetrics {
+public:
+	std::atomic<uint64_t> generations              = 0;
+	std::atomic<uint64_t> evaluations              = 0; // Fitness function calls, cache hits are not counted
+	std::atomic<uint64_t> arenaOverflowAllocations = 0; // Scratch allocations that went to the global allocator
+	std::atomic<uint64_t> batchBusyUs              = 0;
+	std::atomic<uint64_t> solvedRuns               = 0;
+	std::atomic<int64_t> stagnantGenerations = 0; // Generations since the best fitness last improved
+	std::atomic<int64_t> arenaBytes          = 0; // Scratch memory used by the last generation
+	std::atomic<double> generationsPerSec      = 0; // Of the last finished batch
+	std::atomic<double> evaluationsPerSec      = 0;
+	std::atomic<double> batchThreadUtilization = 0; // Busy time of the last batch over the wall time since its launch
+	std::atomic<int> bestFitness = 0;
+	std::atomic<int> maxFitness  = 0;
+	std::atomic<int> avgFitness  = 0;
+	std::atomic<int> minFitness  = 0;
+	std::atomic<int> optimalFitness    = 0;
+	std::atomic<int> batchesInFlight   = 0;
+	std::atomic<int> checkpointsInFlight = 0;
+	std::atomic<int64_t> sweepJobsQueued = 0;
+	std::atomic<int64_t> snapshotExportsQueued = 0;
+
+	void startRun(int initialBestFitness, int optimalFitnessPrm) noexcept;
+	void recordGeneration(int generationBestFitness, size_t usedArenaBytes, size_t overflowAllocationAmount) noexcept;
+
+	// Each series gets a session label with the paired session number, HELP and TYPE are written once per metric
+	[[nodiscard]] static std::string toPrometheusText(const std::vector<std::pair<int, const GaMetrics*>>& sessions);
+};
+
+// Serves the text of renderFunc to HTTP GET /metrics from a background thread. The endpoint is a port or host:port
+// (always bound to the loopback address) or unix:<path> for a Unix socket.
+class MetricsServer {
+public:
+#ifdef _WIN32
+	using Socket_t = uintptr_t;
+#else
+	using Socket_t = int;
+#endif
+	static constexpr Socket_t INVALID_SOCKET_HANDLE = static_cast<Socket_t>(-1);
+
+	MetricsServer() = default;
+	MetricsServer(const MetricsServer&) = delete;
+	MetricsServer& operator=(const MetricsServer&) = delete;
+	~MetricsServer();
+
+	bool start(const std::string& endpoint, std::function<std::string()> renderFunc);
+	void stop();
+	[[nodiscard]] bool isRunning() const noexcept;
+
+private:
+	std::jthread m_thread;
+	std::function<std::string()> m_renderFunc;
+	std::string m_unixSocketPath;
+	Socket_t m_listenSocket = INVALID_SOCKET_HANDLE;
+
+	[[nodiscard]] bool openTcpSocket(const std::string& endpoint);
+	[[nodiscard]] bool openUnixSocket(const std::string& path);
+	void serve(std::stop_token stopToken);
+	void handleClient(Socket_t client) const;
+	static void closeSocket(Socket_t socket) noexcept;
+};
@@ -2,6 +2,7 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <type_traits>
+#include <cstdint>
 
 #define CHECK_INPUT_OUTPUT_VALIDITY false
 #if CHECK_INPUT_OUTPUT_VALIDITY
@@ -25,6 +26,33 @@
 namespace MyUtils {
 	void centerText(sf::Text& text) noexcept;
 
+	[[nodiscard]] constexpr uint64_t mixHash(uint64_t value) noexcept {
+		value += 0x9E3779B97F4A7C15ULL;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+
+	// splitmix64 as a UniformRandomBitGenerator: cheap to construct, so every random stream can get its own
+	class SplitMix64 {
+	public:
+		using result_type = uint64_t;
+
+		constexpr explicit SplitMix64(uint64_t seed = 0) noexcept
+			: m_state{ seed } {}
+
+		[[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+		[[nodiscard]] static constexpr result_type max() noexcept { return UINT64_MAX; }
+
+		constexpr result_type operator()() noexcept {
+			m_state += 0x9E3779B97F4A7C15ULL;
+			return mixHash(m_state);
+		}
+
+	private:
+		uint64_t m_state = 0;
+	};
+
 	template <typename T>
 	requires std::is_same_v<T, sf::Sprite> || std::is_same_v<T, sf::Shape> || std::is_same_v<T, sf::Text>
 	void setScale(T& element, sf::Vector2f relVal, bool maintainRatio) noexcept {
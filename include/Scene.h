@@ -5,7 +5,8 @@
 
 enum class SceneType : uint8_t {
 	None = 0,
-	Algorithm
+	Algorithm,
+	Sessions
 };
 
 
@@ -16,6 +17,7 @@ class Scene {
 
 public:
 	explicit Scene(GameEngine* gameEngine);
+	virtual ~Scene() = default;
 
 	[[nodiscard]] const ActionMap_t& getActionMap() const noexcept;
 
@@ -33,7 +35,7 @@ protected:
 
 	void registerAction(sf::Keyboard::Key inputKey, ActionType actionType);
 	void drawEntities() const;
-	void drawEntities(const std::string& tag) const;
-	void drawEntitiesExcept(const std::string& tag) const;
+	void drawEntities(TagId_t tag) const;
+	void drawEntitiesExcept(TagId_t tag) const;
 	void drawEntity(Entity entity) const;
 };
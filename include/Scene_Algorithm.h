@@ -4,31 +4,114 @@
 #include <queue>
 #include <array>
 #include <future>
+#include <stop_token>
+#include <atomic>
 #include <ranges>
 #include <algorithm>
 #include <utility>
+#include <unordered_set>
+#include <optional>
+#include <span>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <iomanip>
+#include <cstring>
+#include <cmath>
 #include "Scene.h"
 #include "Timer.h"
+#include "Individual.h"
+#include "FitnessCache.h"
+#include "FitnessHistory.h"
+#include "GridRenderer.h"
+#include "TripleBuffer.h"
+#include "Checkpoint.h"
+#include "Sweep.h"
+#include "FitnessPlugin.h"
+#include "ThreadPlacement.h"
+#include "GenerationArena.h"
+#include "Tracer.h"
+#include "Metrics.h"
+#include "SnapshotExporter.h"
 
-using Gene_t = std::vector<int>;
+inline constexpr int MAX_SESSION_AMOUNT = 16;
+inline constexpr int64_t FALLBACK_FRAME_TIME_US = 16'667; // Frame time assumed when the framerate is unlimited (limit 0)
+// Trace names of the GA batch thread of every session, the tracer keeps the pointers
+inline constexpr std::array<const char*, MAX_SESSION_AMOUNT> BATCH_THREAD_NAMES = { "GA batch 1", "GA batch 2", "GA batch 3", "GA batch 4", "GA batch 5", "GA batch 6", "GA batch 7", "GA batch 8", "GA batch 9", "GA batch 10", "GA batch 11", "GA batch 12", "GA batch 13", "GA batch 14", "GA batch 15", "GA batch 16" };
 
-class Individual {
+using Population_t  = std::vector<Individual>;
+using Rng_t         = MyUtils::SplitMix64;
+using FitnessFunc_t = std::function<void(std::span<const Individual* const> individuals, std::span<int> fitness)>; // Scores a whole batch per call
+using ColorFunc_t   = std::function<Gene_t(const Individual& individual)>;
+using OptimalFunc_t = std::function<int(int gridSize)>;
+
+class PopulationBatch {
 public:
-	Gene_t gene;
-	int fitness = 0;
+	Population_t population;
+	Gene_t colorGene;
+	uint64_t seed          = 0;
+	uint64_t traceChecksum = 0;
+	uint64_t bestHash   = 0;
+	int64_t elapsedUs   = 0;
+	int64_t startGeneration = 0;
+	const char* threadName = BATCH_THREAD_NAMES[0];
+	int cpu             = -1; // Core the batch thread is pinned to, -1 leaves it to the OS
+	int generationsDone = 0;
+	int solveTimeMs     = 0;
+	bool isSolved       = false;
+};
 
-	Individual() {}
+class GeneticParameters {
+public:
+	std::atomic<int> mutationRate             = 20;
+	std::atomic<int> randomGenesRate          = 5;
+	std::atomic<int> eliteSurvivalRate        = 10;
+	std::atomic<bool> shouldReplaceDuplicates = false;
+	std::atomic<CrossoverType> crossoverType  = CrossoverType::SinglePoint;
+	std::atomic<bool> isSteadyState           = false;
+	std::atomic<int> steadyStateChildAmount   = 2;
+};
 
-	Individual(Gene_t&& genePrm)
-		: gene(std::move(genePrm)) {
+using WorstHeap_t = std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>>; // (fitness, index), worst individual on top
 
-		INPUT_VALIDITY(!this->gene.empty());
-	}
+class SteadyStateIndex {
+public:
+	WorstHeap_t worstHeap;
+	std::unordered_multiset<uint64_t> hashes;
+	int64_t totalFitness = 0;
 };
 
-using Population_t  = std::vector<Individual>;
-using FitnessFunc_t = std::function<int(const Individual& individual)>;
-using ColorFunc_t   = std::function<Gene_t(const Individual& individual)>;
+class PopulationSnapshot {
+public:
+	Gene_t bestGene;
+	Gene_t colorGene;
+	int runId           = 0;
+	int generationsDone = 0;
+	int maxFitness      = 0;
+	int minFitness      = 0;
+	int avgFitness      = 0;
+};
+
+using SnapshotBuffer_t = TripleBuffer<PopulationSnapshot>;
+
+class ControlValues {
+public:
+	int boxSize           = 0;
+	int populationSize    = 0;
+	int mutationRate      = 0;
+	int randomGenesRate   = 0;
+	int eliteSurvivalRate = 0;
+	int batchTimeBudgetMs = 0;
+	int fitnessFuncIndex  = 0;
+	int steadyStateChildAmount = 0;
+};
+
+enum class RngStream : uint8_t {
+	Initial = 0,
+	Offspring,
+	Duplicates,
+	Shuffle
+};
 
 enum class GeneticOperation : uint8_t {
 	Mutation = 0,
@@ -39,20 +122,31 @@ enum class GeneticOperation : uint8_t {
 class Scene_Algorithm : public Scene {
 
 public:
-	Scene_Algorithm(GameEngine* gameEngine);
+	Scene_Algorithm(GameEngine* gameEngine, int sessionNumber = 1);
+	~Scene_Algorithm() override;
+
+	void update() override;
+	void sDoAction(const Action& action) override;
+	void sRender() override;
+
+	void setSessionTabsFunc(std::function<void()> sessionTabsFunc);
+	void setWindowChangedFunc(std::function<void()> windowChangedFunc);
+	void setGaThreadAmount(size_t gaThreadAmount) noexcept;
+	[[nodiscard]] int getSessionNumber() const noexcept;
+	[[nodiscard]] const std::string& getFitnessFuncName() const noexcept;
+	[[nodiscard]] const GaMetrics& getMetrics() const noexcept;
+
 private:
 	Population_t m_population;
 
-	std::vector<int> m_maxFitnessValues;
-	std::vector<int> m_minFitnessValues;
-	std::vector<int> m_avgFitnessValues;
+	FitnessHistory m_fitnessHistory = FitnessHistory(1'024, 1'024);
 
 	std::vector<FitnessFunc_t> m_fitnessFunctions = {
-		[this](const Individual& individual) -> int { return evaluationSudoku(individual); },
-		[this](const Individual& individual) -> int { return evaluationCheckers(individual); },
-		[this](const Individual& individual) -> int { return evaluationMax(individual); },
-		[this](const Individual& individual) -> int { return evaluationMin(individual); },
-		[this](const Individual& individual) -> int { return evaluationDistToCenter(individual); }
+		makeFitnessFunc(evaluationSudoku),
+		makeFitnessFunc(evaluationCheckers),
+		makeFitnessFunc(evaluationMax),
+		makeFitnessFunc(evaluationMin),
+		makeFitnessFunc(evaluationDistToCenter)
 	};
 	std::vector<ColorFunc_t> m_colorFunctions = {
 		[this](const Individual& individual) -> Gene_t { return colorSudoku(individual); },
@@ -61,51 +155,145 @@ private:
 		[this](const Individual& individual) -> Gene_t { return colorMax(individual); },
 		[this](const Individual& individual) -> Gene_t { return colorMax(individual); }
 	};
+	std::vector<OptimalFunc_t> m_optimalFunctions = {
+		[](int gridSize) -> int { return optimalSudoku(gridSize); },
+		[](int gridSize) -> int { return optimalMax(gridSize); },
+		[](int gridSize) -> int { return optimalMax(gridSize); },
+		[](int gridSize) -> int { return optimalMax(gridSize); },
+		[](int gridSize) -> int { return optimalDistToCenter(gridSize); }
+	};
 	std::vector<float> m_colorWeights = { 0.3f, 1.f, 1.f, 1.f, 1.f };
+	std::vector<std::string> m_fitnessFuncNames = { "Sudoku", "Checkers", "Max", "Min", "DistToCenter" };
+	std::string m_pluginDirectory = "plugins";
+	std::string m_tracePath = "trace.json";
+	ThreadPlacement m_threadPlacement;
+	size_t m_gaThreadAmount = 1; // Affinity cores taken by the GA threads of all sessions, sweep workers use the ones after them
 
-	std::future<Population_t> m_futurePopulation;
+	GeneticParameters m_parameters;
+	std::stop_source m_stopSource;
+	std::future<PopulationBatch> m_futurePopulation;
+	std::shared_ptr<FitnessCache> m_fitnessCache;
+	SnapshotBuffer_t m_snapshots;
+	PopulationSnapshot m_shownSnapshot;
 	Gene_t m_colorGene;
+	uint64_t m_seed          = 0;
+	uint64_t m_configSeed    = 0;
+	uint64_t m_traceChecksum = 0;
+	uint64_t m_bestHash = 0;
+	uint64_t m_batchStartEvaluations = 0;
+	Timer m_runTimer;
+	ControlValues m_controlValues;
+
+	std::future<bool> m_futureCheckpoint;
+	std::string m_checkpointPath = "checkpoint.bin";
+	Timer m_checkpointTimer;
+	int m_checkpointIntervalSec = 0;
+	bool m_shouldResumeFromCheckpoint = false;
+	bool m_isCheckpointRequested      = false;
+
+	Sweep m_sweep;
+	SweepSettings m_sweepSettings;
+	std::string m_sweepCsvPath = "sweep_results.csv";
+	bool m_isSweepWindowOpen    = false;
+	bool m_shouldSortSweepTable = false;
+
+	GaMetrics m_metrics;
+	GenerationArena m_generationArena; // Scratch of the batch thread, kept across batches so it stops growing after the first generations
+	std::function<void()> m_sessionTabsFunc;   // Draws the session tabs at the top of the controls window
+	std::function<void()> m_windowChangedFunc; // Resizes the grids of all sessions after the window mode changed
+	int m_sessionNumber = 1; // Sessions after the first one pin to later cores and write to their own files
+
+	SnapshotExporter m_snapshotExporter;
+	GridRenderer m_exportRenderer;
+	sf::RenderTexture m_exportTexture;
+	std::string m_exportDirectory = "snapshots";
+	int64_t m_nextExportGeneration = 0;
+	int m_exportIntervalGenerations = 0; // 0 turns the periodic export off
+	int m_exportImageSize  = 720;
+	int m_exportGridSize   = 0;
+	int m_exportedBestFitness = 0;
+	bool m_shouldExportOnBest = false;
+	bool m_hasExportedBest    = false;
 
 	float m_relativeGridSize = 3.f / 4.f;
 	float m_gridPhysicalSize = 0;
 
 	int m_curFitnessFuncIndex  = 0;
-	int m_generationsPerUpdate = 10;
-	int m_updateLimit          = 5'000;
-	int m_curUpdate            = 0;
+	int m_generationsPerUpdate    = 10;
+	int m_maxGenerationsPerUpdate = 100'000;
+	int m_batchTimeBudgetMs       = 0;
 	int m_populationSize       = 100;
-	int m_mutationRate         = 20;
-	int m_randomGenesRate      = 5;
-	int m_eliteSurvivalRate    = 10;
 	int m_gridSize = 9;
+	size_t m_fitnessCacheCapacity = 1 << 16;
+	int64_t m_curGeneration        = 0;
+	int64_t m_batchStartGeneration = 0;
+	int64_t m_solveGeneration      = 0;
+	int m_runId                = 0;
+	int m_batchStartTimeMs     = 0;
+	int64_t m_batchStartTimeUs = 0;
+	int m_solveTimeMs          = 0;
 
-	Entity m_cell;
+	GridRenderer m_gridRenderer;
 	bool m_isPopulationUpdating          = false;
 	bool m_shouldDiscardFuturePopulation = false;
+	bool m_isSolved                      = false;
 
 
 	void init();
+	void loadFromConfig();
+	[[nodiscard]] std::string getSessionPath(const std::string& path) const;
+	void registerPlugins();
 	void reset();
-	[[nodiscard]] static Population_t initPopulation(int populationSize, int gridSize);
-	[[nodiscard]] static Individual getRandomGenesIndividual(int gridSize);
-	[[nodiscard]] static int getRandomNum(int rngStart, int rngEnd);
-	static void evaluatePopulation(Population_t& population, const FitnessFunc_t& fitnessFunc) noexcept;
-	static void sortMostFitInividual(Population_t& population);
+	void cancelPopulationUpdate();
+	[[nodiscard]] static Population_t initPopulation(int populationSize, int gridSize, uint64_t seed);
+	[[nodiscard]] static Rng_t getStreamRng(uint64_t seed, RngStream stream, int64_t generation, size_t index) noexcept;
+	[[nodiscard]] static uint64_t foldTraceChecksum(uint64_t checksum, const Population_t& population) noexcept;
+	[[nodiscard]] static Individual getRandomGenesIndividual(int gridSize, Rng_t& rng);
+	[[nodiscard]] static int getRandomNum(int rngStart, int rngEnd, Rng_t& rng);
+	static void evaluatePopulation(Population_t& population, const FitnessFunc_t& fitnessFunc, FitnessCache& fitnessCache, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+	[[nodiscard]] static FitnessFunc_t makeFitnessFunc(int (*evaluationFunc)(const Individual& individual));
+	[[nodiscard]] static const Individual& getMostFitIndividual(const Population_t& population);
+	void resizePopulation();
+	void receiveSnapshot();
 	void addGenerationToGraph();
-	[[nodiscard]] static int getTotalPopulationFitness(const Population_t& population);
+	[[nodiscard]] static int64_t getTotalPopulationFitness(const Population_t& population);
 	[[nodiscard]] static std::pair<int, int> getMinMaxPopulationFitness(const Population_t& population);
 	[[nodiscard]] static float computeGridPhysicalSize(sf::Vector2u windowSize, float relativeGridSize) noexcept;
-	void resizeCell(float relativeDif);
-	[[nodiscard]] static Population_t updatePopulation(Population_t population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate, int generationsPerUpdate, int framerateLimit, const FitnessFunc_t& fitnessFunc);
-	[[nodiscard]] static Population_t geneticAlgorithmOperations(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate);
-	[[nodiscard]] static std::vector<int> getEliteIndividualsIndices(const Population_t& population, int eliteSurvivalRate);
+	void recordSolution(int64_t generation, int timeMs);
+	[[nodiscard]] int64_t getFrameTimeUs() const noexcept;
+	[[nodiscard]] int64_t getBatchTimeBudgetUs() const noexcept;
+	void adaptGenerationsPerUpdate(int generationsDone, int64_t elapsedUs);
+	void updateMetrics();
+	void restartSnapshotExport();
+	void exportSnapshotIfDue();
+	void exportSnapshot(int64_t generation);
+	[[nodiscard]] float getColorShare() const noexcept;
+	void saveCheckpoint();
+	[[nodiscard]] CheckpointData captureCheckpoint() const;
+	bool loadCheckpoint();
+	void launchPopulationUpdate();
+	[[nodiscard]] static PopulationBatch updatePopulation(PopulationBatch batch, int gridSize, const GeneticParameters& parameters, int generationsPerUpdate, int64_t timeBudgetUs, int64_t publishIntervalUs, const FitnessFunc_t& fitnessFunc, int optimalFitness, std::shared_ptr<FitnessCache> fitnessCache, const ColorFunc_t& colorFunc, SnapshotBuffer_t& snapshots, GaMetrics& metrics, GenerationArena& arena, int runId, std::stop_token stopToken);
+	[[nodiscard]] static SweepRunResult runSweepJob(const SweepConfig& config, uint64_t seed, int gridSize, const FitnessFunc_t& fitnessFunc, int optimalFitness, bool shouldReplaceDuplicates, bool isSteadyState, int steadyStateChildAmount, int maxGenerations, int timeLimitMs, size_t fitnessCacheCapacity, GenerationArena& arena, std::stop_token stopToken);
+	void startSweep();
+	static void publishSnapshot(PopulationBatch& batch, const ColorFunc_t& colorFunc, SnapshotBuffer_t& snapshots, int runId);
+	static void fillSnapshot(PopulationSnapshot& snapshot, const Population_t& population, const Individual& mostFitIndividual, const Gene_t& colorGene, int generationsDone, int runId);
+	[[nodiscard]] static Population_t geneticAlgorithmOperations(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate, CrossoverType crossoverType, uint64_t seed, int64_t generation, std::pmr::memory_resource* scratch);
+	[[nodiscard]] static Individual createOffspring(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int recombinationRate, CrossoverType crossoverType, int64_t totalPopulationFitness, Rng_t& rng);
+	[[nodiscard]] static std::pmr::vector<int> getEliteIndividualsIndices(const Population_t& population, int eliteSurvivalRate, std::pmr::memory_resource* scratch);
 	[[nodiscard]] static int getPercentageValue(int totalSize, int percentage) noexcept;
-	[[nodiscard]] static GeneticOperation selectGeneticOperation(int mutationRate, int randomGenesRate, int recombinationRate);
-	[[nodiscard]] static int rouletteIndexSelect(const Population_t& population, int pickValue) noexcept;
-	[[nodiscard]] static std::array<Individual, 2> recombineIndividuals(const Individual& individual1, const Individual& individual2);
-	static void shufflePopulation(Population_t& population);
+	[[nodiscard]] static GeneticOperation selectGeneticOperation(int mutationRate, int randomGenesRate, int recombinationRate, Rng_t& rng);
+	[[nodiscard]] static int rouletteIndexSelect(const Population_t& population, int64_t totalPopulationFitness, Rng_t& rng);
+	[[nodiscard]] static std::array<Individual, 2> recombineIndividuals(const Individual& individual1, const Individual& individual2, CrossoverType crossoverType, Rng_t& rng);
+	static void uniformCrossover(std::array<Individual, 2>& individuals, Rng_t& rng, uint64_t& hashDelta) noexcept;
+	static void swapTraitRange(std::array<Individual, 2>& individuals, size_t start, size_t end, uint64_t& hashDelta) noexcept;
+	static void shufflePopulation(Population_t& population, uint64_t seed, int64_t generation);
+	static void replaceDuplicates(Population_t& population, int gridSize, uint64_t seed, int64_t generation, std::pmr::memory_resource* scratch);
+	[[nodiscard]] static SteadyStateIndex buildSteadyStateIndex(const Population_t& population);
+	static int steadyStateOperations(Population_t& population, SteadyStateIndex& steadyState, int gridSize, int childAmount, int mutationRate, int randomGenesRate, CrossoverType crossoverType, bool shouldReplaceDuplicates, const FitnessFunc_t& fitnessFunc, FitnessCache& fitnessCache, uint64_t seed, int64_t generation, uint64_t& traceChecksum, std::pmr::memory_resource* scratch);
 
 	[[nodiscard]] static int evaluationSudoku(const Individual& individual);
+	static void markTrait(TraitSet_t& seenOnce, TraitSet_t& seenTwice, Trait_t trait) noexcept;
+	[[nodiscard]] static int countUniqueTraits(const TraitSet_t& seenOnce, const TraitSet_t& seenTwice) noexcept;
 	[[nodiscard]] static int evaluationCheckers(const Individual& individual);
 	[[nodiscard]] static int evaluationMax(const Individual& individual);
 	[[nodiscard]] static int evaluationMin(const Individual& individual);
@@ -114,24 +302,40 @@ private:
 	[[nodiscard]] static Gene_t colorSudoku(const Individual& individual);
 	[[nodiscard]] static Gene_t colorMax(const Individual& individual);
 
+	[[nodiscard]] static int optimalSudoku(int gridSize) noexcept;
+	[[nodiscard]] static int optimalMax(int gridSize) noexcept;
+	[[nodiscard]] static int optimalDistToCenter(int gridSize) noexcept;
+
 #pragma region GUI
 	void gui();
 	void controls();
+	void syncControlValues();
 	void sliderGridSize();
 	void sliderPopulationSize();
 	void sliderMutationRate();
 	void sliderRandomGenesRate();
 	void sliderEliteSurvivalRate();
+	void sliderBatchTimeBudget();
 	void comboWindowSize();
+	void resizeGrid();
 	[[nodiscard]] static int getOptimalScreenSizeIndex(sf::Vector2i maxSceenSize, const std::vector<int>& screenSizes, int selectedIndex) noexcept;
 	void comboFitnessFunc();
+	void checkboxReplaceDuplicates();
+	void checkboxSteadyState();
+	void sliderSteadyStateChildren();
+	void comboCrossover();
 	void buttonPause();
+	void buttonsCheckpoint();
+	void textRunStats();
+	void buttonSweep();
+	void buttonTrace();
+	void sweepWindow();
+	void sweepSettingsControls();
+	static void sweepRangeInput(const char* label, SweepRange& range, int minValue, int maxValue, bool hasSteps);
+	void sweepResultsTable();
+	[[nodiscard]] static double getSweepColumnValue(const SweepSummary& summary, int column) noexcept;
 	void graph();
 #pragma endregion 
 
-	void update() override;
-	void sDoAction(const Action& action) override;
-	void sRender() override;
-	void drawCells();
-	void drawBoxLines();
+	void drawGrid();
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "Scene.h"
+#include "Scene_Algorithm.h"
+#include "Metrics.h"
+#include "ThreadPlacement.h"
+
+
+// Runs several independent GA sessions in one window. Each session has its own fitness function, parameters, population
+// and batch thread, and the tabs at the top of the controls pick the one that is drawn and controlled. Hidden sessions
+// keep running. Sessions are not throttled against each other, their batch threads are scheduled by the OS.
+class Scene_Sessions : public Scene {
+public:
+	explicit Scene_Sessions(GameEngine* gameEngine);
+	~Scene_Sessions() override;
+
+private:
+	std::vector<std::unique_ptr<Scene_Algorithm>> m_sessions;
+	mutable std::mutex m_sessionsMutex; // Guards m_sessions against the metrics server thread
+	MetricsServer m_metricsServer;      // Declared after m_sessions, so it stops serving before the sessions go away
+	std::string m_metricsEndpoint = "none";
+	ThreadPlacement m_threadPlacement; // Cores of the shared worker pool, the sessions parse their own copy
+	size_t m_activeSessionIndex = 0;
+	int m_initialSessionAmount  = 1;
+
+	// Tab changes are requested while the active session draws its controls and applied once it has finished
+	bool m_shouldAddSession = false;
+	bool m_shouldSelectActiveTab = false;
+	std::optional<size_t> m_sessionIndexToClose;
+	std::optional<size_t> m_sessionIndexToSelect;
+
+	void init();
+	void loadFromConfig();
+	void update() override;
+	void sDoAction(const Action& action) override;
+	void sRender() override;
+	void sessionTabs();
+	void applyTabRequests();
+	void addSession();
+	void closeSession(size_t sessionIndex);
+	void updateGaThreadAmount();
+	void resizeSessions();
+	[[nodiscard]] int getFreeSessionNumber() const;
+	[[nodiscard]] std::string renderMetrics() const;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <stop_token>
+#include <atomic>
+#include "MyUtils.h"
+
+
+inline constexpr size_t SNAPSHOT_EXPORT_QUEUE_CAPACITY = 8;
+
+class SnapshotExportJob {
+public:
+	sf::Image image;
+	std::string path;
+};
+
+// Encodes images to PNG and writes them on a background thread. push() never waits: when the queue is full the
+// image is dropped, so a slow disk costs snapshots instead of frames. Queued images are still written on destruction.
+class SnapshotExporter {
+public:
+	explicit SnapshotExporter(size_t queueCapacity = SNAPSHOT_EXPORT_QUEUE_CAPACITY);
+	SnapshotExporter(const SnapshotExporter&) = delete;
+	SnapshotExporter& operator=(const SnapshotExporter&) = delete;
+	~SnapshotExporter();
+
+	bool push(sf::Image&& image, std::string path);
+	[[nodiscard]] size_t getQueuedAmount() const;
+	[[nodiscard]] size_t getWrittenAmount() const noexcept;
+	[[nodiscard]] size_t getDroppedAmount() const noexcept;
+
+private:
+	std::deque<SnapshotExportJob> m_queue;
+	mutable std::mutex m_mutex;
+	std::condition_variable_any m_condition;
+	std::atomic<size_t> m_writtenAmount = 0;
+	std::atomic<size_t> m_droppedAmount = 0;
+	size_t m_queueCapacity = 0;
+	std::jthread m_thread; // Declared last, so the queue it drains is still alive while it joins
+
+	void run(std::stop_token stopToken);
+};
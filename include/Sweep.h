@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <string>
+#include <functional>
+#include <future>
+#include <stop_token>
+#include <atomic>
+#include <cstdint>
+#include "MyUtils.h"
+#include "Individual.h"
+#include "ThreadPlacement.h"
+#include "Tracer.h"
+#include "GenerationArena.h"
+
+
+enum class SweepSampling : uint8_t {
+	Grid = 0,
+	Random,
+	LatinHypercube
+};
+
+class SweepRange {
+public:
+	int min   = 0;
+	int max   = 0;
+	int steps = 1;
+};
+
+class SweepSettings {
+public:
+	SweepRange populationSize    = { 50, 200, 3 };
+	SweepRange mutationRate      = { 0, 40, 3 };
+	SweepRange randomGenesRate   = { 0, 20, 3 };
+	SweepRange eliteSurvivalRate = { 0, 20, 3 };
+	std::array<bool, CROSSOVER_TYPE_AMOUNT> crossoverTypes = { true }; // Crossover operators the sweep picks from
+	ThreadPlacement placement; // Worker i is pinned to core firstWorkerIndex + i, the thread amount defaults to the cores left
+	size_t firstWorkerIndex = 0; // Placement indices below it belong to GA batch threads
+	SweepSampling sampling = SweepSampling::Grid;
+	uint64_t seed      = 1;
+	int sampleAmount   = 32;
+	int seedAmount     = 3;
+	int maxGenerations = 2'000;
+	int timeLimitMs    = 5'000;
+	int threadAmount   = 0;
+};
+
+class SweepConfig {
+public:
+	int populationSize    = 0;
+	int mutationRate      = 0;
+	int randomGenesRate   = 0;
+	int eliteSurvivalRate = 0;
+	CrossoverType crossoverType = CrossoverType::SinglePoint;
+};
+
+class SweepRunResult {
+public:
+	uint64_t seed = 0;
+	double timeToBestMs      = 0;
+	double runTimeMs         = 0;
+	double generationsPerSec = 0;
+	int configIndex      = 0;
+	int bestFitness      = 0;
+	int finalFitness     = 0;
+	int generations      = 0;
+	int generationOfBest = 0;
+	bool isSolved = false;
+	bool isDone   = false;
+};
+
+class SweepSummary {
+public:
+	SweepConfig config;
+	double avgBestFitness       = 0;
+	double avgTimeToBestMs      = 0;
+	double avgGenerationsPerSec = 0;
+	double expectedRunTimeMs    = 0; // Time spent over all seeds per solved seed, infinite when no seed solved
+	int solvedAmount = 0;
+	int runAmount    = 0;
+};
+
+using SweepJobFunc_t = std::function<SweepRunResult(const SweepConfig& config, uint64_t seed, GenerationArena& arena, std::stop_token stopToken)>; // The arena is kept by the worker across its jobs
+
+class Sweep {
+public:
+	~Sweep();
+
+	void start(const SweepSettings& settings, SweepJobFunc_t jobFunc);
+	void cancel();
+	bool update();
+	[[nodiscard]] bool isRunning() const noexcept;
+	[[nodiscard]] size_t getDoneAmount() const noexcept;
+	[[nodiscard]] size_t getJobAmount() const noexcept;
+	[[nodiscard]] std::vector<SweepSummary>& getSummaries() noexcept;
+	bool writeCsv(const std::string& path) const;
+
+	[[nodiscard]] static std::vector<SweepConfig> sampleConfigs(const SweepSettings& settings);
+
+private:
+	std::vector<SweepConfig> m_configs;
+	std::vector<uint64_t> m_seeds;
+	std::vector<SweepRunResult> m_results;
+	std::vector<SweepSummary> m_summaries;
+	std::vector<std::future<void>> m_workers;
+	SweepJobFunc_t m_jobFunc;
+	std::stop_source m_stopSource;
+	std::atomic<size_t> m_nextJob = 0;
+	std::atomic<size_t> m_doneAmount = 0;
+	bool m_isRunning = false;
+
+	void runJobs(size_t workerIndex, ThreadPlacement placement, std::stop_token stopToken);
+	void summarize();
+	[[nodiscard]] static std::vector<int> sampleGrid(const SweepRange& range);
+	[[nodiscard]] static int sampleUniform(const SweepRange& range, MyUtils::SplitMix64& rng) noexcept;
+	[[nodiscard]] static std::vector<int> sampleLatinHypercube(const SweepRange& range, int sampleAmount, MyUtils::SplitMix64& rng);
+};
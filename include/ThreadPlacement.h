@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <optional>
+#include <cstdint>
+#include "MyUtils.h"
+#if defined(__linux__) && !defined(_WIN32)
+#include <sched.h>
+#endif
+
+
+inline constexpr int MAX_PINNED_CPU = 1'023;
+
+// Cores that worker threads are pinned to, worker i runs on core i modulo the core amount.
+// Memory a worker allocates after pinning is first touched there, so it lands on the worker's NUMA node.
+class ThreadPlacement {
+public:
+	ThreadPlacement() = default;
+	explicit ThreadPlacement(std::vector<int> cpus);
+
+	[[nodiscard]] static std::optional<ThreadPlacement> parse(const std::string& cpuList);
+	static bool pinCurrentThread(int cpu);
+
+	[[nodiscard]] bool isEnabled() const noexcept;
+	[[nodiscard]] size_t getCpuAmount() const noexcept;
+	[[nodiscard]] int getCpu(size_t workerIndex) const noexcept;
+
+private:
+	std::vector<int> m_cpus;
+};
+
+// Pins the current thread to a core for its lifetime and restores the previous cores afterwards. std::async may run
+// tasks on pooled threads (MSVC does), which would otherwise keep the core of an earlier task. A negative core pins nothing.
+class ScopedThreadPin {
+public:
+	explicit ScopedThreadPin(int cpu);
+	~ScopedThreadPin();
+	ScopedThreadPin(const ScopedThreadPin&) = delete;
+	ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+private:
+#ifdef _WIN32
+	uintptr_t m_previousMask = 0;
+#elif defined(__linux__)
+	cpu_set_t m_previousMask;
+#endif
+	bool m_isPinned = false;
+};
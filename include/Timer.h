@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include "MyUtils.h"
 
 
@@ -8,15 +9,18 @@ class Timer {
 	using Clock_t = std::chrono::steady_clock;
 	using TimePoint_t = Clock_t::time_point;
 	using Milliseconds_t = std::chrono::milliseconds;
+	using Microseconds_t = std::chrono::microseconds;
 
 public:
 	Timer() noexcept;
 	explicit Timer(int msLimit) noexcept;
 
 	void start() noexcept;
+	void start(int msElapsed) noexcept;
 	[[nodiscard]] int getTimeLimit() const noexcept;
 	[[nodiscard]] bool timeRanOut() const noexcept;
 	[[nodiscard]] int timeElapsed() const noexcept;
+	[[nodiscard]] int64_t timeElapsedUs() const noexcept;
 	void setTimeLimit(int msLimit) noexcept;
 	void pause() noexcept;
 
@@ -26,5 +30,5 @@ private:
 	Milliseconds_t m_timeLimit = {};
 	bool m_isPaused = false;
 
-	[[nodiscard]] Milliseconds_t duration() const noexcept;
+	[[nodiscard]] Clock_t::duration duration() const noexcept;
 };
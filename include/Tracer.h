@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "MyUtils.h"
+
+
+inline constexpr size_t TRACE_CHUNK_SIZE   = 4'096;
+inline constexpr size_t TRACE_CHUNK_AMOUNT = 64; // Per thread, later events of a full thread are dropped
+
+class TraceEvent {
+public:
+	const char* name = nullptr; // Has to outlive the tracer, in practice a string literal
+	int64_t beginUs    = 0;
+	int64_t durationUs = 0;
+};
+
+// Opt-in timeline of named scopes. Every thread appends to its own buffer without locks, and writeJson turns the
+// events recorded since start() into Chrome trace JSON, which Perfetto and chrome://tracing open.
+class Tracer {
+public:
+	static void start();
+	static void stop() noexcept;
+	[[nodiscard]] static bool isEnabled() noexcept;
+	static void record(const char* name, int64_t beginUs, int64_t endUs);
+	static void setThreadName(const char* name);
+	static bool writeJson(const std::string& path);
+	[[nodiscard]] static int64_t nowUs() noexcept;
+
+private:
+	class Chunk {
+	public:
+		std::array<TraceEvent, TRACE_CHUNK_SIZE> events;
+	};
+
+	// Written by one thread at a time: a buffer is handed to the next thread only after its owner exited
+	class ThreadBuffer {
+	public:
+		std::array<std::unique_ptr<Chunk>, TRACE_CHUNK_AMOUNT> chunks;
+		std::atomic<size_t> size = 0;
+		std::atomic<uint64_t> epoch = 0; // Trace the events belong to, a buffer of an older trace is empty
+		std::atomic<const char*> threadName = nullptr;
+		int threadId = 0;
+	};
+
+	class ThreadBufferLease {
+	public:
+		ThreadBufferLease();
+		~ThreadBufferLease();
+
+		ThreadBuffer* buffer = nullptr;
+	};
+
+	static inline std::atomic<bool> s_isEnabled = false;
+	static inline std::atomic<int64_t> s_sessionStartUs = 0;
+	static inline std::atomic<uint64_t> s_epoch = 0; // Incremented by every start()
+	static inline std::mutex s_buffersMutex;
+	static inline std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+	static inline std::vector<ThreadBuffer*> s_freeBuffers;
+
+	[[nodiscard]] static ThreadBuffer& getThreadBuffer();
+};
+
+class TraceScope {
+public:
+	explicit TraceScope(const char* name) noexcept;
+	~TraceScope();
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* m_name;
+	int64_t m_beginUs = -1; // -1 when tracing was off as the scope began
+};
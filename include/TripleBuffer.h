@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "MyUtils.h"
+
+
+template <typename T>
+class TripleBuffer {
+public:
+	[[nodiscard]] T& getWriteBuffer() noexcept {
+		return m_buffers[m_writeIndex];
+	}
+
+
+	void publish() noexcept {
+		uint8_t prevMiddle = m_middle.exchange(m_writeIndex | m_dirtyBit, std::memory_order_acq_rel);
+		m_writeIndex = prevMiddle & m_indexMask;
+	}
+
+
+	bool update() noexcept {
+		if (!(m_middle.load(std::memory_order_relaxed) & m_dirtyBit)) {
+			return false;
+		}
+
+		uint8_t prevMiddle = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+		m_readIndex = prevMiddle & m_indexMask;
+		return true;
+	}
+
+
+	[[nodiscard]] const T& read() const noexcept {
+		return m_buffers[m_readIndex];
+	}
+
+
+private:
+	static constexpr uint8_t m_dirtyBit  = 0b100;
+	static constexpr uint8_t m_indexMask = 0b011;
+
+	std::array<T, 3> m_buffers;
+	std::atomic<uint8_t> m_middle = 1;
+	uint8_t m_writeIndex = 0;
+	uint8_t m_readIndex  = 2;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <thread>
+#include <stop_token>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include "MyUtils.h"
+#include "ThreadPlacement.h"
+
+
+// Long-lived threads for short data-parallel loops. A loop pays no thread start and never runs on a pooled thread that
+// kept the core of an earlier pinned task. init() places the threads on the Affinity cores, until then they are not pinned.
+class WorkerPool {
+public:
+	explicit WorkerPool(size_t threadAmount);
+	~WorkerPool();
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	[[nodiscard]] static WorkerPool& Instance();
+
+	// Restarts the threads, one pinned to every placement core from firstWorkerIndex on. Without placement they are
+	// not pinned, and there is one per hardware thread besides the caller of run().
+	void init(const ThreadPlacement& placement, size_t firstWorkerIndex);
+
+	// Calls task(i) for every i below taskAmount and returns once all calls finished. The calling thread takes part.
+	// A call made while another one runs, for example from inside a task, runs all of its tasks on the caller.
+	// The first exception thrown by a task is rethrown here.
+	void run(size_t taskAmount, const std::function<void(size_t)>& task);
+	[[nodiscard]] size_t getThreadAmount() const noexcept;
+
+private:
+	std::mutex m_runMutex; // Held by the caller of run() for the whole call
+	std::mutex m_mutex;
+	std::condition_variable_any m_workCondition;
+	std::condition_variable m_doneCondition;
+	const std::function<void(size_t)>* m_task = nullptr; // nullptr between runs
+	size_t m_taskAmount = 0;
+	std::atomic<size_t> m_nextTask = 0;
+	uint64_t m_runId = 0;
+	int m_busyWorkerAmount = 0;
+	std::exception_ptr m_exception;
+	std::vector<std::jthread> m_threads; // Declared last, so the threads stop before the state they use goes away
+
+	void startThreads(const std::vector<int>& cpus);
+	void stopThreads() noexcept;
+	void work(std::stop_token stopToken);
+	void runTasks(const std::function<void(size_t)>& task, size_t taskAmount);
+};
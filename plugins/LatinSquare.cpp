@@ -0,0 +1,42 @@
+#include "FitnessPluginApi.h"
+#include <bitset>
+
+// Example fitness plugin: a Latin square, a Sudoku without the box constraint.
+// Fitness counts the unique traits of every row and column.
+
+extern "C" {
+
+GA_PLUGIN_EXPORT uint32_t ga_plugin_api_version(void) {
+	return GA_PLUGIN_API_VERSION;
+}
+
+GA_PLUGIN_EXPORT const char* ga_plugin_name(void) {
+	return "Latin square";
+}
+
+GA_PLUGIN_EXPORT void ga_fitness_batch(const uint8_t* genes, size_t genomeAmount, int32_t gridSize, int32_t* fitness) {
+	size_t geneSize = static_cast<size_t>(gridSize) * gridSize;
+
+	for (size_t genome = 0; genome < genomeAmount; genome++) {
+		const uint8_t* gene = genes + genome * geneSize;
+		int32_t result = 0;
+
+		for (int32_t line = 0; line < gridSize; line++) {
+			std::bitset<256> rowTraits;
+			std::bitset<256> colTraits;
+			for (int32_t i = 0; i < gridSize; i++) {
+				rowTraits.set(gene[line * gridSize + i]);
+				colTraits.set(gene[i * gridSize + line]);
+			}
+			result += static_cast<int32_t>(rowTraits.count() + colTraits.count());
+		}
+
+		fitness[genome] = result;
+	}
+}
+
+GA_PLUGIN_EXPORT int32_t ga_optimal_fitness(int32_t gridSize) {
+	return 2 * gridSize * gridSize;
+}
+
+}
@@ -0,0 +1,194 @@
+#include "Checkpoint.h"
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+bool Checkpoint::save(const std::string& path, const CheckpointData& data) {
+	INPUT_VALIDITY(!path.empty());
+	INPUT_VALIDITY(data.gridSize > 0 && data.populationSize > 0);
+	INPUT_VALIDITY(data.genes.size() == static_cast<size_t>(data.populationSize) * data.gridSize * data.gridSize);
+	INPUT_VALIDITY(data.fitness.size() == static_cast<size_t>(data.populationSize));
+
+	Header header;
+	header.gridSize          = data.gridSize;
+	header.populationSize    = data.populationSize;
+	header.mutationRate      = data.mutationRate;
+	header.randomGenesRate   = data.randomGenesRate;
+	header.eliteSurvivalRate = data.eliteSurvivalRate;
+	header.shouldReplaceDuplicates = data.shouldReplaceDuplicates ? 1 : 0;
+	header.generation        = data.generation;
+	header.runTimeMs         = data.runTimeMs;
+	header.crossoverType     = data.crossoverType;
+	header.steadyStateChildAmount = data.steadyStateChildAmount;
+	header.historySize        = data.history.size();
+	header.fitnessFuncNameSize = data.fitnessFuncName.size();
+	header.historyArchiveSize = data.historyArchiveSize;
+	header.historyBucketWidth = data.historyBucketWidth;
+	header.historyTotalSize   = data.historyTotalSize;
+	header.seed               = data.seed;
+	header.traceChecksum      = data.traceChecksum;
+
+	// Everything is laid out in one buffer so the file is produced by a single write
+	std::vector<char> buffer(getFileSize(header));
+	char* cursor = buffer.data();
+	auto append = [&cursor](const void* source, size_t byteAmount) {
+		if (byteAmount > 0) {
+			std::memcpy(cursor, source, byteAmount);
+			cursor += byteAmount;
+		}
+	};
+	append(&header, sizeof(Header));
+	append(data.genes.data(), data.genes.size() * sizeof(uint8_t));
+	append(data.fitness.data(), data.fitness.size() * sizeof(int32_t));
+	append(data.history.data(), data.history.size() * sizeof(FitnessSample));
+	append(data.fitnessFuncName.data(), data.fitnessFuncName.size());
+
+	OUTPUT_VALIDITY(cursor == buffer.data() + buffer.size());
+
+	// Written next to the target and renamed over it, so a preempted save never leaves a torn checkpoint
+	std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			std::cerr << "Checkpoint::save: Cannot open file with path \"" << tempPath << "\"\n";
+			return false;
+		}
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		if (!file) {
+			std::cerr << "Checkpoint::save: Cannot write file with path \"" << tempPath << "\"\n";
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, path, error);
+	if (error) {
+		std::cerr << "Checkpoint::save: Cannot replace file with path \"" << path << "\": " << error.message() << "\n";
+		return false;
+	}
+
+	return true;
+}
+
+std::optional<CheckpointData> Checkpoint::load(const std::string& path) {
+	INPUT_VALIDITY(!path.empty());
+
+#ifdef _WIN32
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		std::cerr << "Checkpoint::load: Cannot open file with path \"" << path << "\"\n";
+		return std::nullopt;
+	}
+	std::vector<char> bytes(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+	return parse(bytes.data(), bytes.size(), path);
+#else
+	int fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		std::cerr << "Checkpoint::load: Cannot open file with path \"" << path << "\"\n";
+		return std::nullopt;
+	}
+
+	struct stat fileStat {};
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0) {
+		std::cerr << "Checkpoint::load: Cannot read size of file with path \"" << path << "\"\n";
+		close(fileDescriptor);
+		return std::nullopt;
+	}
+
+	size_t byteAmount = static_cast<size_t>(fileStat.st_size);
+	void* mapping = mmap(nullptr, byteAmount, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	close(fileDescriptor);
+	if (mapping == MAP_FAILED) {
+		std::cerr << "Checkpoint::load: Cannot map file with path \"" << path << "\"\n";
+		return std::nullopt;
+	}
+
+	std::optional<CheckpointData> result = parse(static_cast<const char*>(mapping), byteAmount, path);
+	munmap(mapping, byteAmount);
+
+	return result;
+#endif
+}
+
+uint64_t Checkpoint::getGeneAmount(const Header& header) noexcept {
+	return static_cast<uint64_t>(header.populationSize) * header.gridSize * header.gridSize;
+}
+
+uint64_t Checkpoint::getFileSize(const Header& header) noexcept {
+	return sizeof(Header)
+		+ getGeneAmount(header) * sizeof(uint8_t)
+		+ static_cast<uint64_t>(header.populationSize) * sizeof(int32_t)
+		+ header.historySize * sizeof(FitnessSample)
+		+ header.fitnessFuncNameSize;
+}
+
+std::optional<CheckpointData> Checkpoint::parse(const char* bytes, size_t byteAmount, const std::string& path) {
+	INPUT_VALIDITY(bytes != nullptr);
+
+	Header header;
+	if (byteAmount < sizeof(Header)) {
+		std::cerr << "Checkpoint::parse: File with path \"" << path << "\" is too small\n";
+		return std::nullopt;
+	}
+	std::memcpy(&header, bytes, sizeof(Header));
+
+	if (header.magic != CHECKPOINT_MAGIC || header.version != CHECKPOINT_VERSION) {
+		std::cerr << "Checkpoint::parse: File with path \"" << path << "\" is not a version " << CHECKPOINT_VERSION << " checkpoint\n";
+		return std::nullopt;
+	}
+	// Counts are bounded by the file size before they are multiplied, so a corrupted header cannot overflow the size check
+	if (header.gridSize <= 0 || header.populationSize <= 0 || header.historySize > byteAmount || header.fitnessFuncNameSize > byteAmount
+		|| static_cast<uint64_t>(header.gridSize) * header.gridSize > byteAmount || static_cast<uint64_t>(header.populationSize) > byteAmount
+		|| header.historyArchiveSize > header.historySize || header.historyBucketWidth == 0 || getFileSize(header) != byteAmount) {
+		std::cerr << "Checkpoint::parse: File with path \"" << path << "\" is corrupted\n";
+		return std::nullopt;
+	}
+
+	CheckpointData data;
+	data.gridSize          = header.gridSize;
+	data.populationSize    = header.populationSize;
+	data.mutationRate      = header.mutationRate;
+	data.randomGenesRate   = header.randomGenesRate;
+	data.eliteSurvivalRate = header.eliteSurvivalRate;
+	data.shouldReplaceDuplicates = header.shouldReplaceDuplicates != 0;
+	data.generation        = header.generation;
+	data.runTimeMs         = header.runTimeMs;
+	data.crossoverType     = header.crossoverType;
+	data.steadyStateChildAmount = header.steadyStateChildAmount;
+	data.historyArchiveSize = header.historyArchiveSize;
+	data.historyBucketWidth = header.historyBucketWidth;
+	data.historyTotalSize   = header.historyTotalSize;
+	data.seed               = header.seed;
+	data.traceChecksum      = header.traceChecksum;
+
+	data.genes.resize(getGeneAmount(header));
+	data.fitness.resize(header.populationSize);
+	data.history.resize(header.historySize);
+	data.fitnessFuncName.resize(header.fitnessFuncNameSize);
+
+	const char* cursor = bytes + sizeof(Header);
+	auto extract = [&cursor](void* destination, size_t byteAmount) {
+		if (byteAmount > 0) {
+			std::memcpy(destination, cursor, byteAmount);
+			cursor += byteAmount;
+		}
+	};
+	extract(data.genes.data(), data.genes.size() * sizeof(uint8_t));
+	extract(data.fitness.data(), data.fitness.size() * sizeof(int32_t));
+	extract(data.history.data(), data.history.size() * sizeof(FitnessSample));
+	extract(data.fitnessFuncName.data(), data.fitnessFuncName.size());
+
+	OUTPUT_VALIDITY(cursor == bytes + byteAmount);
+
+	return data;
+}
@@ -5,17 +5,21 @@ Entity::Entity() noexcept {}
 Entity::Entity(EntityId_t entityId) noexcept
 	: m_id{ entityId } {
 
-	INPUT_VALIDITY(entityId >= 0);
+	INPUT_VALIDITY(entityId != INVALID_ENTITY_ID);
 }
 
 EntityId_t Entity::getId() const noexcept {
 	return m_id;
 }
 
-const std::string& Entity::getTag() const noexcept {
+TagId_t Entity::getTag() const noexcept {
 	return EntityMemoryPool::Instance().getTag(m_id);
 }
 
+const std::string& Entity::getTagName() const noexcept {
+	return EntityMemoryPool::Instance().getTagName(getTag());
+}
+
 bool Entity::isAlive() const noexcept {
 	return EntityMemoryPool::Instance().isAlive(m_id);
 }
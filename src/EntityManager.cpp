@@ -6,16 +6,31 @@ void EntityManager::update() {
 	removeEntities();
 }
 
-Entity EntityManager::addEntity(const std::string& tag) {
+Entity EntityManager::addEntity(TagId_t tag) {
 	Entity entity = EntityMemoryPool::Instance().addEntity(tag);
 	m_entitiesToAdd.emplace_back(entity);
 	return entity;
 }
 
+Entity EntityManager::addEntity(const std::string& tag) {
+	return addEntity(EntityMemoryPool::Instance().registerTag(tag));
+}
+
 void EntityManager::addEntities() {
 	for (const auto& entity : m_entitiesToAdd) {
+		TagId_t tag = entity.getTag();
+		uint32_t entityIndex = EntityMemoryPool::getIndex(entity.getId());
+		if (tag >= m_entitiesByTag.size()) {
+			m_entitiesByTag.resize(static_cast<size_t>(tag) + 1);
+		}
+		if (entityIndex >= m_tagListPositions.size()) {
+			m_tagListPositions.resize(static_cast<size_t>(entityIndex) + 1);
+		}
+
+		std::vector<Entity>& tagList = m_entitiesByTag[tag];
+		m_tagListPositions[entityIndex] = static_cast<uint32_t>(tagList.size());
+		tagList.emplace_back(entity);
 		m_entities.emplace_back(entity);
-		m_entityMap[entity.getTag()].emplace_back(entity);
 	}
 	m_entitiesToAdd.clear();
 }
@@ -23,8 +38,8 @@ void EntityManager::addEntities() {
 void EntityManager::removeEntities() {
 	auto needErase = [this](const auto& entity) {
 		if (!entity.isAlive()) {
-			EntityMemoryPool::Instance().resetComponents(entity.getId());
-			removeFromEntityMap(entity);
+			removeFromTagList(entity);
+			EntityMemoryPool::Instance().release(entity.getId());
 			return true;
 		}
 
@@ -32,23 +47,19 @@ void EntityManager::removeEntities() {
 	};
 
 	auto eraseVec = std::ranges::remove_if(m_entities, needErase);
-
-	if (!eraseVec.empty()) {
-		EntityMemoryPool::Instance().m_nextEntityId = EntityMemoryPool::Instance().getFreeIndexFromBack();
-	}
-
 	m_entities.erase(eraseVec.begin(), eraseVec.end());
 }
 
-void EntityManager::removeFromEntityMap(Entity entity) {
-	auto& vec = m_entityMap[entity.getTag()];
-	const auto entityIt = std::ranges::find_if(vec, [entity](Entity target) {
-		return target.getId() == entity.getId();
-	});
+void EntityManager::removeFromTagList(Entity entity) {
+	std::vector<Entity>& tagList = m_entitiesByTag[entity.getTag()];
+	uint32_t position = m_tagListPositions[EntityMemoryPool::getIndex(entity.getId())];
 
-	if (entityIt != vec.end()) {
-		vec.erase(entityIt);
-	}
+	INPUT_VALIDITY(position < tagList.size() && tagList[position].getId() == entity.getId());
+
+	Entity lastEntity = tagList.back();
+	tagList[position] = lastEntity;
+	m_tagListPositions[EntityMemoryPool::getIndex(lastEntity.getId())] = position;
+	tagList.pop_back();
 }
 
 const std::vector<Entity>& EntityManager::getEntities() const noexcept {
@@ -59,18 +70,16 @@ std::vector<Entity>& EntityManager::getEntities() noexcept {
 	return m_entities;
 }
 
-const std::vector<Entity>& EntityManager::getEntities(const std::string& tag) const {
-	const auto entityIt = m_entityMap.find(tag);
-
-	INPUT_VALIDITY(entityIt != m_entityMap.end());
+const std::vector<Entity>& EntityManager::getEntities(TagId_t tag) const noexcept {
+	static const std::vector<Entity> noEntities;
 
-	return entityIt->second;
+	return tag < m_entitiesByTag.size() ? m_entitiesByTag[tag] : noEntities;
 }
 
-std::vector<Entity>& EntityManager::getEntities(const std::string& tag) {
-	const auto entityIt = m_entityMap.find(tag);
+const std::vector<Entity>& EntityManager::getEntities(const std::string& tag) const {
+	std::optional<TagId_t> tagId = EntityMemoryPool::Instance().findTag(tag);
 
-	INPUT_VALIDITY(entityIt != m_entityMap.end());
+	INPUT_VALIDITY(tagId.has_value());
 
-	return entityIt->second;
+	return getEntities(*tagId);
 }
@@ -2,69 +2,124 @@
 #include "Entity.h"
 
 
-EntityMemoryPool::EntityMemoryPool(EntityId_t poolSize)
-	: m_tags(poolSize)
-	, m_alive(poolSize)
-	, m_poolSize{ poolSize } {
+EntityMemoryPool::EntityMemoryPool(size_t initialCapacity) {
+	reserve(initialCapacity);
+}
+
+Entity EntityMemoryPool::addEntity(TagId_t tag) {
+	INPUT_VALIDITY(tag < m_tagNames.size());
+
+	uint32_t index = 0;
+	if (!m_freeIndices.empty()) {
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else {
+		INPUT_VALIDITY(m_slots.size() < ENTITY_MAX_AMOUNT);
+
+		index = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+		m_tags.emplace_back(INVALID_TAG_ID);
+	}
+
+	Slot& slot = m_slots[index];
+	slot.isAlive = true;
+	m_tags[index] = tag;
+	m_aliveAmount++;
 
-	INPUT_VALIDITY(poolSize >= 0);
+	OUTPUT_VALIDITY(index < m_slots.size());
 
-	initTuple();
+	return Entity(makeId(index, slot.generation));
 }
 
-Entity EntityMemoryPool::addEntity(const std::string& tag) {
-	INPUT_VALIDITY(!tag.empty());
+void EntityMemoryPool::release(EntityId_t entityId) {
+	INPUT_VALIDITY(isValid(entityId));
 
-	EntityId_t index = isPoolFull() ? getFreeIndexFromFront() : m_nextEntityId++;
+	uint32_t index = getIndex(entityId);
+	Slot& slot = m_slots[index];
+	if (slot.isAlive) {
+		slot.isAlive = false;
+		m_aliveAmount--;
+	}
 
-	OUTPUT_VALIDITY(index < m_poolSize);
+	// The generation wraps after 4096 reuses of a slot, a handle kept that long could match again
+	slot.generation = (slot.generation + 1) & ENTITY_GENERATION_MASK;
+	removeComponents(index);
+	m_freeIndices.emplace_back(index);
+}
 
-	m_alive[index] = true;
-	m_tags[index] = tag;
-	return Entity(index);
+EntityMemoryPool& EntityMemoryPool::Instance() {
+	static EntityMemoryPool pool(ENTITY_MEMORY_POOL_INITIAL_CAPACITY);
+	return pool;
 }
 
-EntityId_t EntityMemoryPool::getFreeIndexFromBack() const noexcept {
-	for (EntityId_t i = m_poolSize; i-- > 0; ) {
-		if (m_alive[i]) {
-			return i + 1;
-		}
+TagId_t EntityMemoryPool::registerTag(const std::string& name) {
+	INPUT_VALIDITY(!name.empty());
+
+	auto [tagIt, isInserted] = m_tagIds.try_emplace(name, static_cast<TagId_t>(m_tagNames.size()));
+	if (isInserted) {
+		INPUT_VALIDITY(m_tagNames.size() < INVALID_TAG_ID);
+
+		m_tagNames.emplace_back(name);
 	}
-	return 0;
+
+	return tagIt->second;
 }
 
-EntityId_t EntityMemoryPool::getFreeIndexFromFront() const noexcept {
-	for (EntityId_t i = 0; i < m_poolSize; i++) {
-		if (!m_alive[i]) {
-			return i;
-		}
+std::optional<TagId_t> EntityMemoryPool::findTag(const std::string& name) const {
+	const auto tagIt = m_tagIds.find(name);
+	if (tagIt == m_tagIds.end()) {
+		return std::nullopt;
 	}
-	return m_poolSize;
+
+	return tagIt->second;
 }
 
-EntityMemoryPool& EntityMemoryPool::Instance() {
-	static EntityMemoryPool pool(ENTITY_MEMORY_POOL_MAX_SIZE);
-	return pool;
+const std::string& EntityMemoryPool::getTagName(TagId_t tag) const noexcept {
+	INPUT_VALIDITY(tag < m_tagNames.size());
+
+	return m_tagNames[tag];
+}
+
+size_t EntityMemoryPool::getTagAmount() const noexcept {
+	return m_tagNames.size();
 }
 
-const std::string& EntityMemoryPool::getTag(EntityId_t entityId) const noexcept {
-	INPUT_VALIDITY(entityId < m_poolSize);
+TagId_t EntityMemoryPool::getTag(EntityId_t entityId) const noexcept {
+	INPUT_VALIDITY(isValid(entityId));
 
-	return m_tags[entityId];
+	return m_tags[getIndex(entityId)];
 }
 
 bool EntityMemoryPool::isAlive(EntityId_t entityId) const noexcept {
-	INPUT_VALIDITY(entityId < m_poolSize);
+	return isValid(entityId) && m_slots[getIndex(entityId)].isAlive;
+}
 
-	return m_alive[entityId];
+bool EntityMemoryPool::isValid(EntityId_t entityId) const noexcept {
+	uint32_t index = getIndex(entityId);
+	return index < m_slots.size() && m_slots[index].generation == getGeneration(entityId);
 }
 
 void EntityMemoryPool::destroy(EntityId_t entityId) noexcept {
-	INPUT_VALIDITY(entityId < m_poolSize);
+	INPUT_VALIDITY(isValid(entityId));
 
-	m_alive[entityId] = false;
+	// The slot is released by EntityManager::update, so the entity stays readable until the end of the frame
+	Slot& slot = m_slots[getIndex(entityId)];
+	if (slot.isAlive) {
+		slot.isAlive = false;
+		m_aliveAmount--;
+	}
 }
 
-bool EntityMemoryPool::isPoolFull() const noexcept {
-	return m_nextEntityId >= m_poolSize;
-}
\ No newline at end of file
+void EntityMemoryPool::reserve(size_t entityAmount) {
+	INPUT_VALIDITY(entityAmount <= ENTITY_MAX_AMOUNT);
+
+	m_slots.reserve(entityAmount);
+	m_tags.reserve(entityAmount);
+	m_freeIndices.reserve(entityAmount);
+	reserveComponents(entityAmount);
+}
+
+size_t EntityMemoryPool::getAliveAmount() const noexcept {
+	return m_aliveAmount;
+}
@@ -0,0 +1,54 @@
+#include "FitnessCache.h"
+
+
+FitnessCache::FitnessCache(size_t capacity)
+	: m_shardCapacity{ std::max<size_t>(1, capacity / FITNESS_CACHE_SHARD_AMOUNT) } {
+
+	INPUT_VALIDITY(capacity > 0);
+
+	for (auto& shard : m_shards) {
+		shard.entries.resize(m_shardCapacity);
+	}
+}
+
+std::optional<int> FitnessCache::find(uint64_t hash) const {
+	const Shard& shard = getShard(hash);
+	std::scoped_lock lock(shard.mutex);
+
+	const Entry& entry = shard.entries[getSlotIndex(hash)];
+	if (entry.isUsed && entry.hash == hash) {
+		return entry.fitness;
+	}
+
+	return std::nullopt;
+}
+
+void FitnessCache::insert(uint64_t hash, int fitness) {
+	Shard& shard = getShard(hash);
+	std::scoped_lock lock(shard.mutex);
+
+	shard.entries[getSlotIndex(hash)] = { hash, fitness, true };
+}
+
+void FitnessCache::clear() {
+	for (auto& shard : m_shards) {
+		std::scoped_lock lock(shard.mutex);
+		std::ranges::fill(shard.entries, Entry{});
+	}
+}
+
+const FitnessCache::Shard& FitnessCache::getShard(uint64_t hash) const noexcept {
+	return m_shards[hash % FITNESS_CACHE_SHARD_AMOUNT];
+}
+
+FitnessCache::Shard& FitnessCache::getShard(uint64_t hash) noexcept {
+	return m_shards[hash % FITNESS_CACHE_SHARD_AMOUNT];
+}
+
+size_t FitnessCache::getSlotIndex(uint64_t hash) const noexcept {
+	size_t result = (hash / FITNESS_CACHE_SHARD_AMOUNT) % m_shardCapacity;
+
+	OUTPUT_VALIDITY(result < m_shardCapacity);
+
+	return result;
+}
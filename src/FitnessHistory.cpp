@@ -0,0 +1,158 @@
+#include "FitnessHistory.h"
+
+
+FitnessHistory::FitnessHistory(size_t recentCapacity, size_t archiveCapacity)
+	: m_recent(recentCapacity)
+	, m_archiveCapacity{ archiveCapacity } {
+
+	INPUT_VALIDITY(recentCapacity > 0);
+	INPUT_VALIDITY(archiveCapacity > 1);
+
+	m_archive.reserve(archiveCapacity + 1);
+}
+
+void FitnessHistory::add(int64_t generation, int maxFitness, int minFitness, int avgFitness) {
+	INPUT_VALIDITY(generation >= 0);
+	INPUT_VALIDITY(minFitness <= maxFitness);
+
+	Sample sample = { static_cast<double>(generation), static_cast<double>(maxFitness), static_cast<double>(minFitness), static_cast<double>(avgFitness), 1 };
+
+	if (m_recentSize == m_recent.size()) {
+		archive(m_recent[m_recentStart]);
+		m_recent[m_recentStart] = sample;
+		m_recentStart = (m_recentStart + 1) % m_recent.size();
+	}
+	else {
+		m_recent[(m_recentStart + m_recentSize) % m_recent.size()] = sample;
+		m_recentSize++;
+	}
+
+	m_totalSize++;
+	m_isPlotDataDirty = true;
+}
+
+void FitnessHistory::clear() noexcept {
+	m_archive.clear();
+	m_recentStart = 0;
+	m_recentSize = 0;
+	m_bucketWidth = 1;
+	m_totalSize = 0;
+	m_isPlotDataDirty = true;
+}
+
+size_t FitnessHistory::size() const noexcept {
+	return m_totalSize;
+}
+
+const FitnessPlotData& FitnessHistory::getPlotData() {
+	if (!m_isPlotDataDirty) {
+		return m_plotData;
+	}
+
+	m_plotData.generations.clear();
+	m_plotData.maxValues.clear();
+	m_plotData.minValues.clear();
+	m_plotData.avgValues.clear();
+
+	for (const auto& bucket : m_archive) {
+		appendPlotPoint(bucket);
+	}
+	for (size_t i = 0; i < m_recentSize; i++) {
+		appendPlotPoint(m_recent[(m_recentStart + i) % m_recent.size()]);
+	}
+
+	m_isPlotDataDirty = false;
+
+	OUTPUT_VALIDITY(m_plotData.generations.size() <= m_archiveCapacity + m_recent.size());
+
+	return m_plotData;
+}
+
+std::vector<FitnessSample> FitnessHistory::getSamples() const {
+	std::vector<FitnessSample> result(m_archive);
+	result.reserve(m_archive.size() + m_recentSize);
+
+	for (size_t i = 0; i < m_recentSize; i++) {
+		result.emplace_back(m_recent[(m_recentStart + i) % m_recent.size()]);
+	}
+
+	return result;
+}
+
+size_t FitnessHistory::getArchiveSize() const noexcept {
+	return m_archive.size();
+}
+
+size_t FitnessHistory::getBucketWidth() const noexcept {
+	return m_bucketWidth;
+}
+
+bool FitnessHistory::restore(const FitnessSample* samples, size_t sampleAmount, size_t archiveSize, size_t bucketWidth, size_t totalSize) {
+	INPUT_VALIDITY(samples != nullptr || sampleAmount == 0);
+
+	if (archiveSize > sampleAmount || archiveSize > m_archiveCapacity || sampleAmount - archiveSize > m_recent.size() || bucketWidth == 0) {
+		std::cerr << "FitnessHistory::restore: Samples do not fit the history capacity\n";
+		return false;
+	}
+
+	clear();
+
+	m_archive.assign(samples, samples + archiveSize);
+	for (size_t i = archiveSize; i < sampleAmount; i++) {
+		m_recent[m_recentSize++] = samples[i];
+	}
+	m_bucketWidth = bucketWidth;
+	m_totalSize = totalSize;
+
+	return true;
+}
+
+void FitnessHistory::archive(const Sample& sample) {
+	if (m_archive.empty() || m_archive.back().sampleAmount >= m_bucketWidth) {
+		m_archive.emplace_back(sample);
+	}
+	else {
+		m_archive.back() = mergeSamples(m_archive.back(), sample);
+	}
+
+	if (m_archive.size() > m_archiveCapacity) {
+		compactArchive();
+	}
+
+	OUTPUT_VALIDITY(m_archive.size() <= m_archiveCapacity);
+}
+
+void FitnessHistory::compactArchive() {
+	size_t mergedSize = 0;
+
+	for (size_t i = 0; i < m_archive.size(); i += 2) {
+		if (i + 1 < m_archive.size()) {
+			m_archive[mergedSize++] = mergeSamples(m_archive[i], m_archive[i + 1]);
+		}
+		else {
+			m_archive[mergedSize++] = m_archive[i];
+		}
+	}
+
+	m_archive.resize(mergedSize);
+	m_bucketWidth *= 2;
+}
+
+FitnessHistory::Sample FitnessHistory::mergeSamples(const Sample& sample1, const Sample& sample2) noexcept {
+	return {
+		sample1.generation,
+		std::max(sample1.maxFitness, sample2.maxFitness),
+		std::min(sample1.minFitness, sample2.minFitness),
+		sample1.avgFitnessSum + sample2.avgFitnessSum,
+		sample1.sampleAmount + sample2.sampleAmount
+	};
+}
+
+void FitnessHistory::appendPlotPoint(const Sample& sample) {
+	INPUT_VALIDITY(sample.sampleAmount > 0);
+
+	m_plotData.generations.emplace_back(sample.generation);
+	m_plotData.maxValues.emplace_back(sample.maxFitness);
+	m_plotData.minValues.emplace_back(sample.minFitness);
+	m_plotData.avgValues.emplace_back(sample.avgFitnessSum / sample.sampleAmount);
+}
@@ -0,0 +1,161 @@
+#include "FitnessPlugin.h"
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+
+static_assert(sizeof(int) == sizeof(int32_t), "Plugins write int32_t fitness straight into int storage");
+
+FitnessPlugin::~FitnessPlugin() {
+	if (m_handle == nullptr) {
+		return;
+	}
+
+#ifdef _WIN32
+	FreeLibrary(static_cast<HMODULE>(m_handle));
+#else
+	dlclose(m_handle);
+#endif
+}
+
+std::shared_ptr<FitnessPlugin> FitnessPlugin::load(const std::string& path) {
+	INPUT_VALIDITY(!path.empty());
+
+	std::shared_ptr<FitnessPlugin> plugin(new FitnessPlugin());
+#ifdef _WIN32
+	plugin->m_handle = LoadLibraryA(path.c_str());
+	if (plugin->m_handle == nullptr) {
+		std::cerr << "FitnessPlugin::load: Cannot load library with path \"" << path << "\", error " << GetLastError() << "\n";
+		return nullptr;
+	}
+#else
+	plugin->m_handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (plugin->m_handle == nullptr) {
+		std::cerr << "FitnessPlugin::load: Cannot load library with path \"" << path << "\": " << dlerror() << "\n";
+		return nullptr;
+	}
+#endif
+
+	auto apiVersionFunc = reinterpret_cast<GaPluginApiVersionFunc>(plugin->getSymbol("ga_plugin_api_version"));
+	auto nameFunc       = reinterpret_cast<GaPluginNameFunc>(plugin->getSymbol("ga_plugin_name"));
+	plugin->m_fitnessBatchFunc   = reinterpret_cast<GaPluginFitnessBatchFunc>(plugin->getSymbol("ga_fitness_batch"));
+	plugin->m_optimalFitnessFunc = reinterpret_cast<GaPluginOptimalFitnessFunc>(plugin->getSymbol("ga_optimal_fitness"));
+	plugin->m_colorFunc          = reinterpret_cast<GaPluginColorFunc>(plugin->getSymbol("ga_color"));
+
+	if (apiVersionFunc == nullptr || nameFunc == nullptr || plugin->m_fitnessBatchFunc == nullptr || plugin->m_optimalFitnessFunc == nullptr) {
+		std::cerr << "FitnessPlugin::load: Library with path \"" << path << "\" does not export the required ga_ functions\n";
+		return nullptr;
+	}
+	if (apiVersionFunc() != GA_PLUGIN_API_VERSION) {
+		std::cerr << "FitnessPlugin::load: Library with path \"" << path << "\" uses API version " << apiVersionFunc() << ", expected " << GA_PLUGIN_API_VERSION << "\n";
+		return nullptr;
+	}
+
+	const char* name = nameFunc();
+	plugin->m_name = name != nullptr && name[0] != '\0' ? name : std::filesystem::path(path).stem().string();
+
+	OUTPUT_VALIDITY(plugin->m_handle != nullptr);
+
+	return plugin;
+}
+
+std::vector<std::shared_ptr<FitnessPlugin>> FitnessPlugin::loadDirectory(const std::string& directory) {
+#ifdef _WIN32
+	static const std::string libraryExtension = ".dll";
+#else
+	static const std::string libraryExtension = ".so";
+#endif
+
+	std::vector<std::shared_ptr<FitnessPlugin>> result;
+	std::error_code error;
+	if (directory.empty() || !std::filesystem::is_directory(directory, error)) {
+		return result;
+	}
+
+	// Sorted so a plugin keeps its fitness function index between runs, which checkpoints rely on
+	std::vector<std::filesystem::path> paths;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+		if (entry.is_regular_file() && entry.path().extension() == libraryExtension) {
+			paths.emplace_back(entry.path());
+		}
+	}
+	std::ranges::sort(paths);
+
+	for (const auto& path : paths) {
+		std::shared_ptr<FitnessPlugin> plugin = load(path.string());
+		if (plugin != nullptr) {
+			result.emplace_back(std::move(plugin));
+		}
+	}
+
+	return result;
+}
+
+void FitnessPlugin::evaluate(std::span<const Individual* const> individuals, std::span<int> fitness) const {
+	INPUT_VALIDITY(individuals.size() == fitness.size());
+
+	if (individuals.empty()) {
+		return;
+	}
+
+	size_t geneSize = individuals[0]->gene.size();
+	int gridSize = static_cast<int>(std::lround(std::sqrt(geneSize)));
+
+	// Genes are gathered back to back so the whole batch crosses the library boundary in one call
+	thread_local std::vector<Trait_t> genes;
+	genes.resize(individuals.size() * geneSize);
+	for (size_t i = 0; i < individuals.size(); i++) {
+		INPUT_VALIDITY(individuals[i]->gene.size() == geneSize);
+		std::ranges::copy(individuals[i]->gene, genes.begin() + i * geneSize);
+	}
+
+	m_fitnessBatchFunc(genes.data(), individuals.size(), gridSize, reinterpret_cast<int32_t*>(fitness.data()));
+
+	for (auto& value : fitness) {
+		value = std::max(0, value);
+	}
+}
+
+Gene_t FitnessPlugin::color(const Individual& individual) const {
+	INPUT_VALIDITY(!individual.gene.empty());
+	INPUT_VALIDITY(m_colorFunc != nullptr);
+
+	int gridSize = static_cast<int>(std::lround(std::sqrt(individual.gene.size())));
+	Gene_t result(individual.gene.size());
+	m_colorFunc(individual.gene.data(), gridSize, result.data());
+
+	for (auto& value : result) {
+		value = std::min(value, static_cast<Trait_t>(gridSize));
+	}
+
+	return result;
+}
+
+int FitnessPlugin::getOptimalFitness(int gridSize) const {
+	INPUT_VALIDITY(gridSize > 0);
+
+	return std::max(0, m_optimalFitnessFunc(gridSize));
+}
+
+bool FitnessPlugin::hasColorFunc() const noexcept {
+	return m_colorFunc != nullptr;
+}
+
+const std::string& FitnessPlugin::getName() const noexcept {
+	return m_name;
+}
+
+void* FitnessPlugin::getSymbol(const char* name) const noexcept {
+#ifdef _WIN32
+	return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(m_handle), name));
+#else
+	return dlsym(m_handle, name);
+#endif
+}
@@ -1,9 +1,10 @@
 #include "GameEngine.h"
-#include "Scene_Algorithm.h"
+#include "Scene_Sessions.h"
 
 
-GameEngine::GameEngine(const std::string& configPath)
-	: m_configPath{ configPath } {
+GameEngine::GameEngine(const std::string& configPath, std::vector<std::string> configOverrides)
+	: m_configPath{ configPath }
+	, m_configOverrides{ std::move(configOverrides) } {
 
 	INPUT_VALIDITY(!configPath.empty());
 
@@ -21,17 +22,11 @@ void GameEngine::init() {
 		std::cerr << "GameEngine::init: Cannot init ImGui\n";
 	}
 	ImPlot::CreateContext();
-	changeScene(SceneType::Algorithm, std::make_unique<Scene_Algorithm>(this), true);
+	changeScene(SceneType::Sessions, std::make_unique<Scene_Sessions>(this), true);
 }
 
 void GameEngine::loadFromConfig() {
-	std::ifstream file(m_configPath);
-	if (!file.is_open()) {
-		std::cerr << "GameEngine::loadFromConfig: Cannot open file with path \"" << m_configPath << "\"\n";
-	}
-
-	std::string line;
-	while (std::getline(file, line)) {
+	for (const auto& line : readConfigLines()) {
 		std::stringstream iss(line);
 		std::string type;
 		iss >> type;
@@ -69,6 +64,9 @@ void GameEngine::run() {
 
 	while (isRunning()) {
 		try {
+			Tracer::setThreadName("Main");
+			TraceScope traceScope("Frame");
+
 			sUserInput();
 
 			currentScene()->update();
@@ -77,9 +75,14 @@ void GameEngine::run() {
 			m_window.clear(sf::Color::White);
 
 			currentScene()->sRender();
-			ImGui::SFML::Render(m_window);
-
-			m_window.display();
+			{
+				TraceScope imguiTraceScope("ImGui render");
+				ImGui::SFML::Render(m_window);
+			}
+			{
+				TraceScope displayTraceScope("Display");
+				m_window.display();
+			}
 		}
 		catch (const std::exception& e) {
 			std::cerr << "GameEngine::run: exception caught: " << e.what() << '\n';
@@ -174,3 +177,31 @@ const Assets& GameEngine::assets() const noexcept {
 const std::string& GameEngine::getConfigPath() const noexcept {
 	return m_configPath;
 }
+
+std::vector<std::string> GameEngine::readConfigLines() const {
+	std::vector<std::string> result;
+
+	std::ifstream file(m_configPath);
+	if (!file.is_open()) {
+		std::cerr << "GameEngine::readConfigLines: Cannot open file with path \"" << m_configPath << "\"\n";
+	}
+
+	auto getType = [](const std::string& line) -> std::string {
+		std::string type;
+		std::stringstream(line) >> type;
+		return type;
+	};
+
+	// A command line override replaces the file line of the same type
+	std::string line;
+	while (std::getline(file, line)) {
+		std::string type = getType(line);
+		bool isOverridden = std::ranges::any_of(m_configOverrides, [&](const std::string& overrideLine) { return getType(overrideLine) == type; });
+		if (!isOverridden) {
+			result.emplace_back(std::move(line));
+		}
+	}
+	result.insert(result.end(), m_configOverrides.begin(), m_configOverrides.end());
+
+	return result;
+}
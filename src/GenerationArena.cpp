@@ -0,0 +1,62 @@
+#include "GenerationArena.h"
+#include <bit>
+
+
+GenerationArena::GenerationArena(size_t capacity)
+	: m_block(std::make_unique_for_overwrite<std::byte[]>(capacity))
+	, m_capacity(capacity) {
+
+	INPUT_VALIDITY(capacity > 0);
+}
+
+void GenerationArena::reset() noexcept {
+	m_offset = 0;
+	if (m_overflowBlocks.empty()) {
+		return;
+	}
+
+	// Grow once to hold everything the last generation needed, so the next one fits in the main block
+	m_capacity = std::bit_ceil(m_capacity + m_overflowSize);
+	m_block = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+	m_overflowBlocks.clear();
+	m_overflowSize = 0;
+}
+
+size_t GenerationArena::getCapacity() const noexcept {
+	return m_capacity;
+}
+
+size_t GenerationArena::getUsedBytes() const noexcept {
+	return m_offset + m_overflowSize;
+}
+
+size_t GenerationArena::getOverflowAmount() const noexcept {
+	return m_overflowBlocks.size();
+}
+
+void* GenerationArena::do_allocate(size_t bytes, size_t alignment) {
+	INPUT_VALIDITY(std::has_single_bit(alignment));
+
+	uintptr_t base = reinterpret_cast<uintptr_t>(m_block.get());
+	uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+	size_t end = static_cast<size_t>(aligned - base) + bytes;
+	if (end <= m_capacity) {
+		m_offset = end;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	size_t overflowSize = bytes + alignment;
+	std::byte* overflowBlock = m_overflowBlocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(overflowSize)).get();
+	m_overflowSize += overflowSize;
+
+	uintptr_t overflowBase = reinterpret_cast<uintptr_t>(overflowBlock);
+	return reinterpret_cast<void*>((overflowBase + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+}
+
+void GenerationArena::do_deallocate(void* /*pointer*/, size_t /*bytes*/, size_t /*alignment*/) noexcept {
+	// Memory is only given back as a whole by reset()
+}
+
+bool GenerationArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
@@ -0,0 +1,154 @@
+#include "GridRenderer.h"
+
+
+GridRenderer::GridRenderer(const sf::Font& font)
+	: m_font{ &font } {}
+
+void GridRenderer::resize(int gridSize, float gridPhysicalSize) {
+	INPUT_VALIDITY(gridSize > 0);
+	INPUT_VALIDITY(gridPhysicalSize > 0);
+
+	if (gridSize != m_gridSize) {
+		m_gridSize = gridSize;
+		buildGlyphAtlas();
+	}
+	m_gridPhysicalSize = gridPhysicalSize;
+
+	buildCells();
+	buildBoxLines();
+
+	OUTPUT_VALIDITY(m_cellQuads.getVertexCount() == m_glyphQuads.getVertexCount());
+}
+
+void GridRenderer::update(const Gene_t& traits, const Gene_t& colorTraits, float colorShare) {
+	INPUT_VALIDITY(traits.size() == m_shownTraits.size());
+	INPUT_VALIDITY(colorTraits.size() == m_shownColors.size());
+	INPUT_VALIDITY(colorShare > 0);
+
+	for (size_t i = 0; i < traits.size(); i++) {
+		int gbColor = 255 - std::min(static_cast<int>(std::round(colorShare * colorTraits[i])), 255);
+		if (gbColor != m_shownColors[i]) {
+			setQuadColor(m_cellQuads, i, sf::Color(255, gbColor, gbColor));
+			m_shownColors[i] = gbColor;
+		}
+
+		if (m_shouldDrawGlyphs && traits[i] != m_shownTraits[i]) {
+			setQuadTexCoords(m_glyphQuads, i, getGlyphRect(traits[i]));
+			m_shownTraits[i] = traits[i];
+		}
+	}
+}
+
+void GridRenderer::draw(sf::RenderTarget& target) const {
+	target.draw(m_cellQuads);
+	if (m_shouldDrawGlyphs) {
+		target.draw(m_glyphQuads, &m_glyphAtlas.getTexture());
+	}
+	target.draw(m_boxLines);
+}
+
+void GridRenderer::buildGlyphAtlas() {
+	m_atlasColumns = static_cast<int>(std::ceil(std::sqrt(m_gridSize)));
+	int atlasRows = (m_gridSize + m_atlasColumns - 1) / m_atlasColumns;
+
+	if (!m_glyphAtlas.create(m_atlasColumns * GLYPH_ATLAS_SLOT_SIZE, atlasRows * GLYPH_ATLAS_SLOT_SIZE)) {
+		std::cerr << "GridRenderer::buildGlyphAtlas: Cannot create glyph atlas\n";
+	}
+	m_glyphAtlas.setSmooth(true);
+	m_glyphAtlas.clear(sf::Color::Transparent);
+
+	float slotSize = static_cast<float>(GLYPH_ATLAS_SLOT_SIZE);
+	sf::Text text;
+	text.setFont(*m_font);
+	text.setCharacterSize(GLYPH_ATLAS_SLOT_SIZE);
+	text.setFillColor(sf::Color::Black);
+	text.setString(std::to_string(m_gridSize));
+	MyUtils::setScale(text, sf::Vector2f(slotSize, slotSize) * (m_gridSize < 10 ? 0.5F : 0.8F), true);
+
+	for (int trait = 0; trait < m_gridSize; trait++) {
+		sf::FloatRect slot = getGlyphRect(trait);
+
+		text.setString(std::to_string(trait + 1));
+		MyUtils::centerText(text);
+		text.setPosition(slot.left + slotSize / 2.F, slot.top + slotSize / 2.F);
+		m_glyphAtlas.draw(text);
+	}
+
+	m_glyphAtlas.display();
+}
+
+void GridRenderer::buildCells() {
+	size_t cellAmount = static_cast<size_t>(m_gridSize) * m_gridSize;
+	float cellSize = m_gridPhysicalSize / m_gridSize;
+	// Digits in cells a few pixels wide are unreadable, at 100x100 the colors alone carry the information
+	m_shouldDrawGlyphs = cellSize >= MIN_GLYPH_CELL_SIZE;
+
+	m_cellQuads.resize(cellAmount * 4);
+	m_glyphQuads.resize(cellAmount * 4);
+
+	for (size_t i = 0; i < cellAmount; i++) {
+		float row = static_cast<float>(i / m_gridSize);
+		float col = static_cast<float>(i % m_gridSize);
+		sf::FloatRect cellRect = { col * cellSize, row * cellSize, cellSize, cellSize };
+
+		setQuad(m_cellQuads, i, cellRect);
+		setQuad(m_glyphQuads, i, cellRect);
+		setQuadColor(m_cellQuads, i, sf::Color::White);
+		setQuadColor(m_glyphQuads, i, sf::Color::White);
+	}
+
+	m_shownTraits.assign(cellAmount, -1);
+	m_shownColors.assign(cellAmount, -1);
+}
+
+void GridRenderer::buildBoxLines() {
+	float cellSize = m_gridPhysicalSize / m_gridSize;
+	int boxSize = static_cast<int>(std::sqrt(m_gridSize));
+
+	m_boxLines.resize(static_cast<size_t>(boxSize - 1) * 2 * 2);
+
+	size_t curIndex = 0;
+	for (int i = 1; i < boxSize; i++) {
+		m_boxLines[curIndex++] = sf::Vertex(sf::Vector2f(cellSize * boxSize * i, 0), sf::Color::Black);
+		m_boxLines[curIndex++] = sf::Vertex(sf::Vector2f(cellSize * boxSize * i, m_gridPhysicalSize), sf::Color::Black);
+
+		m_boxLines[curIndex++] = sf::Vertex(sf::Vector2f(0, cellSize * boxSize * i), sf::Color::Black);
+		m_boxLines[curIndex++] = sf::Vertex(sf::Vector2f(m_gridPhysicalSize, cellSize * boxSize * i), sf::Color::Black);
+	}
+}
+
+sf::FloatRect GridRenderer::getGlyphRect(int trait) const noexcept {
+	INPUT_VALIDITY(trait >= 0 && trait < m_gridSize);
+
+	float slotSize = static_cast<float>(GLYPH_ATLAS_SLOT_SIZE);
+	float row = static_cast<float>(trait / m_atlasColumns);
+	float col = static_cast<float>(trait % m_atlasColumns);
+
+	return { col * slotSize, row * slotSize, slotSize, slotSize };
+}
+
+void GridRenderer::setQuad(sf::VertexArray& quads, size_t quadIndex, sf::FloatRect rect) noexcept {
+	sf::Vertex* quad = &quads[quadIndex * 4];
+
+	quad[0].position = { rect.left, rect.top };
+	quad[1].position = { rect.left + rect.width, rect.top };
+	quad[2].position = { rect.left + rect.width, rect.top + rect.height };
+	quad[3].position = { rect.left, rect.top + rect.height };
+}
+
+void GridRenderer::setQuadColor(sf::VertexArray& quads, size_t quadIndex, sf::Color color) noexcept {
+	sf::Vertex* quad = &quads[quadIndex * 4];
+
+	for (int i = 0; i < 4; i++) {
+		quad[i].color = color;
+	}
+}
+
+void GridRenderer::setQuadTexCoords(sf::VertexArray& quads, size_t quadIndex, sf::FloatRect rect) noexcept {
+	sf::Vertex* quad = &quads[quadIndex * 4];
+
+	quad[0].texCoords = { rect.left, rect.top };
+	quad[1].texCoords = { rect.left + rect.width, rect.top };
+	quad[2].texCoords = { rect.left + rect.width, rect.top + rect.height };
+	quad[3].texCoords = { rect.left, rect.top + rect.height };
+}
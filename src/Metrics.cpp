@@ -0,0 +1,287 @@
+#include "Metrics.h"
+#include <sstream>
+#include <cstring>
+#include <filesystem>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+
+template<typename T>
+static void writeMetric(std::ostringstream& oss, const char* name, const char* type, const char* help, const std::vector<std::pair<int, const GaMetrics*>>& sessions, std::atomic<T> GaMetrics::* value) {
+	oss << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+	for (const auto& [sessionNumber, metrics] : sessions) {
+		oss << name << "{session=\"" << sessionNumber << "\"} " << (metrics->*value).load(std::memory_order_relaxed) << '\n';
+	}
+}
+
+void GaMetrics::startRun(int initialBestFitness, int optimalFitnessPrm) noexcept {
+	bestFitness.store(initialBestFitness, std::memory_order_relaxed);
+	optimalFitness.store(optimalFitnessPrm, std::memory_order_relaxed);
+	stagnantGenerations.store(0, std::memory_order_relaxed);
+}
+
+void GaMetrics::recordGeneration(int generationBestFitness, size_t usedArenaBytes, size_t overflowAllocationAmount) noexcept {
+	// Only the GA batch thread records generations, so the read-modify-write of the best fitness does not race
+	generations.fetch_add(1, std::memory_order_relaxed);
+	if (generationBestFitness > bestFitness.load(std::memory_order_relaxed)) {
+		bestFitness.store(generationBestFitness, std::memory_order_relaxed);
+		stagnantGenerations.store(0, std::memory_order_relaxed);
+	}
+	else {
+		stagnantGenerations.fetch_add(1, std::memory_order_relaxed);
+	}
+	arenaBytes.store(static_cast<int64_t>(usedArenaBytes), std::memory_order_relaxed);
+	arenaOverflowAllocations.fetch_add(overflowAllocationAmount, std::memory_order_relaxed);
+}
+
+std::string GaMetrics::toPrometheusText(const std::vector<std::pair<int, const GaMetrics*>>& sessions) {
+	std::ostringstream oss;
+	oss.precision(10);
+
+	writeMetric(oss, "ga_generations_total", "counter", "Generations computed by the GA batch thread.", sessions, &GaMetrics::generations);
+	writeMetric(oss, "ga_evaluations_total", "counter", "Individuals scored by the fitness function, fitness cache hits excluded.", sessions, &GaMetrics::evaluations);
+	writeMetric(oss, "ga_generations_per_second", "gauge", "Generation throughput of the last finished batch.", sessions, &GaMetrics::generationsPerSec);
+	writeMetric(oss, "ga_evaluations_per_second", "gauge", "Evaluation throughput of the last finished batch.", sessions, &GaMetrics::evaluationsPerSec);
+	writeMetric(oss, "ga_best_fitness", "gauge", "Best fitness reached in the current run.", sessions, &GaMetrics::bestFitness);
+	writeMetric(oss, "ga_max_fitness", "gauge", "Highest fitness in the last published population.", sessions, &GaMetrics::maxFitness);
+	writeMetric(oss, "ga_avg_fitness", "gauge", "Average fitness of the last published population.", sessions, &GaMetrics::avgFitness);
+	writeMetric(oss, "ga_min_fitness", "gauge", "Lowest fitness in the last published population.", sessions, &GaMetrics::minFitness);
+	writeMetric(oss, "ga_optimal_fitness", "gauge", "Fitness that solves the current problem.", sessions, &GaMetrics::optimalFitness);
+	writeMetric(oss, "ga_stagnant_generations", "gauge", "Generations since the best fitness last improved.", sessions, &GaMetrics::stagnantGenerations);
+	writeMetric(oss, "ga_solved_runs_total", "counter", "Runs that reached the optimal fitness.", sessions, &GaMetrics::solvedRuns);
+	writeMetric(oss, "ga_arena_bytes", "gauge", "Scratch memory used by the last generation.", sessions, &GaMetrics::arenaBytes);
+	writeMetric(oss, "ga_arena_overflow_allocations_total", "counter", "Scratch allocations that did not fit the generation arena and went to the global allocator.", sessions, &GaMetrics::arenaOverflowAllocations);
+	writeMetric(oss, "ga_batch_busy_microseconds_total", "counter", "Time the GA batch thread spent computing generations.", sessions, &GaMetrics::batchBusyUs);
+	writeMetric(oss, "ga_batch_thread_utilization", "gauge", "Busy time of the last batch divided by the wall time since its launch.", sessions, &GaMetrics::batchThreadUtilization);
+	writeMetric(oss, "ga_batches_in_flight", "gauge", "GA batches queued or running.", sessions, &GaMetrics::batchesInFlight);
+	writeMetric(oss, "ga_checkpoints_in_flight", "gauge", "Checkpoint writes queued or running.", sessions, &GaMetrics::checkpointsInFlight);
+	writeMetric(oss, "ga_sweep_jobs_queued", "gauge", "Parameter sweep runs that have not finished yet.", sessions, &GaMetrics::sweepJobsQueued);
+	writeMetric(oss, "ga_snapshot_exports_queued", "gauge", "Grid images waiting to be encoded and written.", sessions, &GaMetrics::snapshotExportsQueued);
+
+	return oss.str();
+}
+
+MetricsServer::~MetricsServer() {
+	stop();
+}
+
+bool MetricsServer::start(const std::string& endpoint, std::function<std::string()> renderFunc) {
+	INPUT_VALIDITY(!isRunning());
+	INPUT_VALIDITY(renderFunc != nullptr);
+
+#ifdef _WIN32
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+		std::cerr << "MetricsServer::start: Cannot initialize Winsock\n";
+		return false;
+	}
+#endif
+
+	bool isOpen = endpoint.starts_with("unix:") ? openUnixSocket(endpoint.substr(5)) : openTcpSocket(endpoint);
+	if (!isOpen) {
+#ifdef _WIN32
+		WSACleanup();
+#endif
+		return false;
+	}
+
+	m_renderFunc = std::move(renderFunc);
+	m_thread = std::jthread([this](std::stop_token stopToken) { serve(stopToken); });
+
+	OUTPUT_VALIDITY(m_listenSocket != INVALID_SOCKET_HANDLE);
+
+	return true;
+}
+
+void MetricsServer::stop() {
+	if (!isRunning()) {
+		return;
+	}
+
+	m_thread.request_stop();
+	m_thread.join();
+	closeSocket(m_listenSocket);
+	m_listenSocket = INVALID_SOCKET_HANDLE;
+	if (!m_unixSocketPath.empty()) {
+		std::error_code error;
+		std::filesystem::remove(m_unixSocketPath, error);
+		m_unixSocketPath.clear();
+	}
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+bool MetricsServer::isRunning() const noexcept {
+	return m_listenSocket != INVALID_SOCKET_HANDLE;
+}
+
+bool MetricsServer::openTcpSocket(const std::string& endpoint) {
+	// Only the port is taken from host:port, the server never listens beyond the loopback address
+	size_t colonPos = endpoint.rfind(':');
+	std::string portText = colonPos == std::string::npos ? endpoint : endpoint.substr(colonPos + 1);
+	int port = 0;
+	try {
+		size_t length = 0;
+		port = std::stoi(portText, &length);
+		port = length == portText.size() ? port : 0;
+	}
+	catch (const std::exception&) {
+		port = 0;
+	}
+	if (port <= 0 || port > 65'535) {
+		std::cerr << "MetricsServer::openTcpSocket: Invalid endpoint \"" << endpoint << "\"\n";
+		return false;
+	}
+
+	Socket_t listenSocket = static_cast<Socket_t>(socket(AF_INET, SOCK_STREAM, 0));
+	if (listenSocket == INVALID_SOCKET_HANDLE) {
+		std::cerr << "MetricsServer::openTcpSocket: Cannot create socket\n";
+		return false;
+	}
+
+	int reuseAddress = 1;
+	setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuseAddress), sizeof(reuseAddress));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(static_cast<uint16_t>(port));
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listenSocket, SOMAXCONN) != 0) {
+		std::cerr << "MetricsServer::openTcpSocket: Cannot listen on 127.0.0.1:" << port << "\n";
+		closeSocket(listenSocket);
+		return false;
+	}
+
+	m_listenSocket = listenSocket;
+	return true;
+}
+
+bool MetricsServer::openUnixSocket(const std::string& path) {
+#ifdef _WIN32
+	std::cerr << "MetricsServer::openUnixSocket: Unix sockets are not supported on Windows, use a port\n";
+	return false;
+#else
+	sockaddr_un address = {};
+	if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+		std::cerr << "MetricsServer::openUnixSocket: Invalid socket path \"" << path << "\"\n";
+		return false;
+	}
+
+	Socket_t listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenSocket == INVALID_SOCKET_HANDLE) {
+		std::cerr << "MetricsServer::openUnixSocket: Cannot create socket\n";
+		return false;
+	}
+
+	// A socket file left behind by a crashed run would make bind fail
+	std::error_code error;
+	std::filesystem::remove(path, error);
+
+	address.sun_family = AF_UNIX;
+	std::memcpy(address.sun_path, path.c_str(), path.size());
+	if (bind(listenSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listenSocket, SOMAXCONN) != 0) {
+		std::cerr << "MetricsServer::openUnixSocket: Cannot listen on \"" << path << "\"\n";
+		closeSocket(listenSocket);
+		return false;
+	}
+
+	m_listenSocket = listenSocket;
+	m_unixSocketPath = path;
+	return true;
+#endif
+}
+
+void MetricsServer::serve(std::stop_token stopToken) {
+	while (!stopToken.stop_requested()) {
+		pollfd listenPoll = {};
+		listenPoll.fd = m_listenSocket;
+		listenPoll.events = POLLIN;
+#ifdef _WIN32
+		int readyAmount = WSAPoll(&listenPoll, 1, METRICS_POLL_INTERVAL_MS);
+#else
+		int readyAmount = poll(&listenPoll, 1, METRICS_POLL_INTERVAL_MS);
+#endif
+		if (readyAmount <= 0) {
+			continue;
+		}
+
+		Socket_t client = static_cast<Socket_t>(accept(m_listenSocket, nullptr, nullptr));
+		if (client != INVALID_SOCKET_HANDLE) {
+			handleClient(client);
+			closeSocket(client);
+		}
+	}
+}
+
+void MetricsServer::handleClient(Socket_t client) const {
+	// Scrapes are rare and tiny, so one client at a time on this thread is enough
+	pollfd clientPoll = {};
+	clientPoll.fd = client;
+	clientPoll.events = POLLIN;
+
+	std::string request;
+	char buffer[512];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < METRICS_MAX_REQUEST_SIZE) {
+#ifdef _WIN32
+		int readyAmount = WSAPoll(&clientPoll, 1, METRICS_POLL_INTERVAL_MS);
+#else
+		int readyAmount = poll(&clientPoll, 1, METRICS_POLL_INTERVAL_MS);
+#endif
+		if (readyAmount <= 0) {
+			return;
+		}
+
+		int receivedSize = static_cast<int>(recv(client, buffer, sizeof(buffer), 0));
+		if (receivedSize <= 0) {
+			return;
+		}
+		request.append(buffer, receivedSize);
+	}
+
+	std::string body;
+	std::string status;
+	if (request.starts_with("GET /metrics ") || request.starts_with("GET /metrics?")) {
+		status = "200 OK";
+		body = m_renderFunc();
+	}
+	else {
+		status = "404 Not Found";
+		body = "Metrics are served at /metrics\n";
+	}
+
+	std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: "
+		+ std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+
+	// A scraper that hung up early must not raise SIGPIPE and end the process
+	size_t sentSize = 0;
+	while (sentSize < response.size()) {
+		int chunkSize = static_cast<int>(send(client, response.data() + sentSize, static_cast<int>(response.size() - sentSize), MSG_NOSIGNAL));
+		if (chunkSize <= 0) {
+			return;
+		}
+		sentSize += chunkSize;
+	}
+}
+
+void MetricsServer::closeSocket(Socket_t socket) noexcept {
+#ifdef _WIN32
+	closesocket(socket);
+#else
+	close(socket);
+#endif
+}
@@ -24,13 +24,13 @@ void Scene::drawEntities() const {
 	}
 }
 
-void Scene::drawEntities(const std::string& tag) const {
+void Scene::drawEntities(TagId_t tag) const {
 	for (const auto& entity : m_entityManager.getEntities(tag)) {
 		drawEntity(entity);
 	}
 }
 
-void Scene::drawEntitiesExcept(const std::string& tag) const {
+void Scene::drawEntitiesExcept(TagId_t tag) const {
 	for (const auto& entity : m_entityManager.getEntities()) {
 		if (entity.getTag() == tag) {
 			continue;
@@ -2,82 +2,265 @@
 #include "GameEngine.h"
 
 
-Scene_Algorithm::Scene_Algorithm(GameEngine* gameEngine)
-	: Scene{ gameEngine } {
+Scene_Algorithm::Scene_Algorithm(GameEngine* gameEngine, int sessionNumber)
+	: Scene{ gameEngine }
+	, m_sessionNumber{ sessionNumber }
+	, m_exportRenderer{ gameEngine->assets().getFont("Roboto") }
+	, m_gridRenderer{ gameEngine->assets().getFont("Roboto") } {
 
 	INPUT_VALIDITY(gameEngine != nullptr);
+	INPUT_VALIDITY(sessionNumber > 0 && sessionNumber <= MAX_SESSION_AMOUNT);
 	INPUT_VALIDITY(m_fitnessFunctions.size() == m_colorFunctions.size() && m_fitnessFunctions.size() == m_colorWeights.size());
+	INPUT_VALIDITY(m_fitnessFunctions.size() == m_optimalFunctions.size() && m_fitnessFunctions.size() == m_fitnessFuncNames.size());
 	for (const auto& weight : m_colorWeights) {
 		INPUT_VALIDITY(weight > 0);
 	}
 	INPUT_VALIDITY(m_relativeGridSize > 0);
 	INPUT_VALIDITY(m_curFitnessFuncIndex >= 0 && m_curFitnessFuncIndex < m_fitnessFunctions.size());
-	INPUT_VALIDITY(m_generationsPerUpdate > 0);
-	INPUT_VALIDITY(m_updateLimit > 0);
-	INPUT_VALIDITY(m_curUpdate == 0);
+	INPUT_VALIDITY(m_generationsPerUpdate > 0 && m_generationsPerUpdate <= m_maxGenerationsPerUpdate);
+	INPUT_VALIDITY(m_batchTimeBudgetMs >= 0);
 	INPUT_VALIDITY(m_populationSize > 0);
-	INPUT_VALIDITY(m_mutationRate >= 0 && m_mutationRate <= 100);
-	INPUT_VALIDITY(m_randomGenesRate >= 0 && m_randomGenesRate <= 100);
-	INPUT_VALIDITY(m_eliteSurvivalRate >= 0 && m_eliteSurvivalRate <= 100);
-	INPUT_VALIDITY(m_gridSize > 0);
+	INPUT_VALIDITY(m_parameters.mutationRate >= 0 && m_parameters.mutationRate <= 100);
+	INPUT_VALIDITY(m_parameters.randomGenesRate >= 0 && m_parameters.randomGenesRate <= 100);
+	INPUT_VALIDITY(m_parameters.eliteSurvivalRate >= 0 && m_parameters.eliteSurvivalRate <= 100);
+	INPUT_VALIDITY(m_gridSize > 0 && m_gridSize <= MAX_GRID_SIZE);
 	int boxSize = static_cast<int>(std::sqrt(m_gridSize));
 	INPUT_VALIDITY(m_gridSize == boxSize * boxSize);
+	INPUT_VALIDITY(m_fitnessCacheCapacity > 0);
+	INPUT_VALIDITY(!m_checkpointPath.empty());
+	INPUT_VALIDITY(m_checkpointIntervalSec >= 0);
 	INPUT_VALIDITY(!m_isPopulationUpdating);
 	INPUT_VALIDITY(!m_shouldDiscardFuturePopulation);
+	INPUT_VALIDITY(!m_isSolved);
 
 	init();
 
 	OUTPUT_VALIDITY(m_population.size() == m_populationSize);
 	OUTPUT_VALIDITY(m_population[0].gene.size() == m_gridSize * m_gridSize);
 	OUTPUT_VALIDITY(m_population[0].gene.size() == m_colorGene.size());
-	OUTPUT_VALIDITY(m_maxFitnessValues.size() == m_minFitnessValues.size() && m_maxFitnessValues.size() == m_avgFitnessValues.size());
-	OUTPUT_VALIDITY(!m_maxFitnessValues.empty());
+	OUTPUT_VALIDITY(m_shownSnapshot.bestGene.size() == m_shownSnapshot.colorGene.size());
+	OUTPUT_VALIDITY(m_fitnessHistory.size() > 0);
 	OUTPUT_VALIDITY(m_gridPhysicalSize > 0);
 }
 
+Scene_Algorithm::~Scene_Algorithm() {
+	m_stopSource.request_stop();
+	if (m_futurePopulation.valid()) {
+		m_futurePopulation.wait();
+	}
+}
+
+void Scene_Algorithm::setSessionTabsFunc(std::function<void()> sessionTabsFunc) {
+	m_sessionTabsFunc = std::move(sessionTabsFunc);
+}
+
+void Scene_Algorithm::setWindowChangedFunc(std::function<void()> windowChangedFunc) {
+	m_windowChangedFunc = std::move(windowChangedFunc);
+}
+
+void Scene_Algorithm::setGaThreadAmount(size_t gaThreadAmount) noexcept {
+	INPUT_VALIDITY(gaThreadAmount > 0);
+
+	m_gaThreadAmount = gaThreadAmount;
+}
+
+int Scene_Algorithm::getSessionNumber() const noexcept {
+	return m_sessionNumber;
+}
+
+const std::string& Scene_Algorithm::getFitnessFuncName() const noexcept {
+	return m_fitnessFuncNames[m_curFitnessFuncIndex];
+}
+
+const GaMetrics& Scene_Algorithm::getMetrics() const noexcept {
+	return m_metrics;
+}
+
 void Scene_Algorithm::init() {
 	registerAction(sf::Keyboard::Escape, ActionType::Quit);
 
-	m_maxFitnessValues = std::vector<int>(m_updateLimit);
-	m_minFitnessValues = std::vector<int>(m_updateLimit);
-	m_avgFitnessValues = std::vector<int>(m_updateLimit);
-
+	loadFromConfig();
+	registerPlugins();
 	reset();
+	resizeGrid();
 
-	m_gridPhysicalSize = computeGridPhysicalSize(m_game->getWindow().getSize(), m_relativeGridSize);
-	float cellSize = m_gridPhysicalSize / m_gridSize;
-	sf::Vector2f cellSizeVec = { cellSize, cellSize };
+	if (m_shouldResumeFromCheckpoint && std::filesystem::exists(m_checkpointPath)) {
+		loadCheckpoint();
+	}
+	syncControlValues();
+	m_checkpointTimer.start();
+}
 
-	m_cell = m_entityManager.addEntity("cell");
-	m_cell.addComponent<CTransform>(cellSizeVec / 2.F);
-	m_cell.addComponent<CShape>(cellSizeVec, sf::Color::White, sf::Color::Black, 0.F);
-	m_cell.addComponent<CText>("0", cellSizeVec / 2.F, m_game->assets().getFont("Roboto"), sf::Color::Black, sf::Color::Black, 0.F);
+void Scene_Algorithm::loadFromConfig() {
+	for (const auto& line : m_game->readConfigLines()) {
+		std::stringstream iss(line);
+		std::string type;
+		iss >> type;
 
-	m_entityManager.update();
+		if (type == "Seed") {
+			iss >> m_configSeed;
+		}
+		else if (type == "Crossover") {
+			int crossoverType = 0;
+			iss >> crossoverType;
+			if (crossoverType < 0 || crossoverType >= CROSSOVER_TYPE_AMOUNT) {
+				std::cerr << "Scene_Algorithm::loadFromConfig: Invalid crossover type " << crossoverType << ", using single point crossover\n";
+				crossoverType = 0;
+			}
+			m_parameters.crossoverType = static_cast<CrossoverType>(crossoverType);
+		}
+		else if (type == "Affinity") {
+			std::string cpuList;
+			iss >> cpuList;
+			std::optional<ThreadPlacement> placement = ThreadPlacement::parse(cpuList);
+			if (!placement) {
+				std::cerr << "Scene_Algorithm::loadFromConfig: Invalid affinity, worker threads are not pinned\n";
+			}
+			m_threadPlacement = placement.value_or(ThreadPlacement());
+			m_sweepSettings.placement = m_threadPlacement;
+		}
+		else if (type == "Trace") {
+			int shouldStartTrace = 0;
+			iss >> m_tracePath >> shouldStartTrace;
+			// Later sessions would restart the recording of the first one
+			if (shouldStartTrace != 0 && m_sessionNumber == 1) {
+				Tracer::start();
+			}
+		}
+		else if (type == "Export") {
+			int shouldExportOnBest = 0;
+			iss >> m_exportDirectory >> m_exportIntervalGenerations >> shouldExportOnBest >> m_exportImageSize;
+			m_shouldExportOnBest = shouldExportOnBest != 0;
+		}
+		else if (type == "Plugins") {
+			iss >> m_pluginDirectory;
+		}
+		else if (type == "Sweep") {
+			iss >> m_sweepCsvPath >> m_sweepSettings.threadAmount;
+		}
+		else if (type == "Checkpoint") {
+			int shouldResume = 0;
+			iss >> m_checkpointPath >> m_checkpointIntervalSec >> shouldResume;
+			m_shouldResumeFromCheckpoint = shouldResume != 0;
+		}
+	}
+
+	if (m_sweepCsvPath.empty() || m_sweepSettings.threadAmount < 0) {
+		std::cerr << "Scene_Algorithm::loadFromConfig: Invalid sweep settings, using defaults\n";
+		m_sweepCsvPath = "sweep_results.csv";
+		m_sweepSettings.threadAmount = 0;
+	}
+	if (m_exportDirectory.empty() || m_exportIntervalGenerations < 0 || m_exportImageSize <= 0) {
+		std::cerr << "Scene_Algorithm::loadFromConfig: Invalid export settings, snapshots are not exported\n";
+		m_exportDirectory = "snapshots";
+		m_exportIntervalGenerations = 0;
+		m_shouldExportOnBest = false;
+		m_exportImageSize = 720;
+	}
+	if (m_tracePath.empty()) {
+		m_tracePath = "trace.json";
+	}
+	if (m_checkpointPath.empty() || m_checkpointIntervalSec < 0) {
+		std::cerr << "Scene_Algorithm::loadFromConfig: Invalid checkpoint settings, periodic checkpoints are disabled\n";
+		m_checkpointPath = "checkpoint.bin";
+		m_checkpointIntervalSec = 0;
+	}
+
+	m_checkpointPath  = getSessionPath(m_checkpointPath);
+	m_sweepCsvPath    = getSessionPath(m_sweepCsvPath);
+	m_exportDirectory = getSessionPath(m_exportDirectory);
+}
+
+std::string Scene_Algorithm::getSessionPath(const std::string& path) const {
+	if (m_sessionNumber == 1) {
+		return path;
+	}
+
+	// "checkpoint.bin" becomes "checkpoint_session2.bin", so sessions never write over each other
+	std::filesystem::path sessionPath(path);
+	if (!sessionPath.has_filename()) {
+		sessionPath = sessionPath.parent_path();
+	}
+	sessionPath.replace_filename(sessionPath.stem().string() + "_session" + std::to_string(m_sessionNumber) + sessionPath.extension().string());
+	return sessionPath.string();
+}
+
+void Scene_Algorithm::registerPlugins() {
+	for (auto& plugin : FitnessPlugin::loadDirectory(m_pluginDirectory)) {
+		m_fitnessFunctions.emplace_back([plugin](std::span<const Individual* const> individuals, std::span<int> fitness) { plugin->evaluate(individuals, fitness); });
+		if (plugin->hasColorFunc()) {
+			m_colorFunctions.emplace_back([plugin](const Individual& individual) -> Gene_t { return plugin->color(individual); });
+		}
+		else {
+			m_colorFunctions.emplace_back([](const Individual& individual) -> Gene_t { return colorMax(individual); });
+		}
+		m_optimalFunctions.emplace_back([plugin](int gridSize) -> int { return plugin->getOptimalFitness(gridSize); });
+		m_colorWeights.emplace_back(1.f);
+		m_fitnessFuncNames.emplace_back(plugin->getName());
+
+		std::cout << "Scene_Algorithm: session " << m_sessionNumber << " loaded fitness plugin \"" << plugin->getName() << "\"\n";
+	}
+
+	OUTPUT_VALIDITY(m_fitnessFunctions.size() == m_colorFunctions.size() && m_fitnessFunctions.size() == m_optimalFunctions.size());
+	OUTPUT_VALIDITY(m_fitnessFunctions.size() == m_colorWeights.size() && m_fitnessFunctions.size() == m_fitnessFuncNames.size());
 }
 
 void Scene_Algorithm::reset() {
-	m_population = initPopulation(m_populationSize, m_gridSize);
-	evaluatePopulation(m_population, m_fitnessFunctions[m_curFitnessFuncIndex]);
-	sortMostFitInividual(m_population);
-	m_colorGene = m_colorFunctions[m_curFitnessFuncIndex](m_population[0]);
+	if (m_configSeed != 0) {
+		m_seed = m_configSeed;
+	}
+	else {
+		std::random_device randomDevice;
+		m_seed = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
+	}
+
+	m_fitnessCache = std::make_shared<FitnessCache>(m_fitnessCacheCapacity);
+	m_population = initPopulation(m_populationSize, m_gridSize, m_seed);
+	evaluatePopulation(m_population, m_fitnessFunctions[m_curFitnessFuncIndex], *m_fitnessCache);
+	m_traceChecksum = foldTraceChecksum(0, m_population);
+
+	const Individual& mostFitIndividual = getMostFitIndividual(m_population);
+	m_colorGene = m_colorFunctions[m_curFitnessFuncIndex](mostFitIndividual);
+	m_bestHash = mostFitIndividual.hash;
+
+	m_runId++;
+	fillSnapshot(m_shownSnapshot, m_population, mostFitIndividual, m_colorGene, 0, m_runId);
 
-	m_curUpdate = 0;
+	m_curGeneration = 0;
+	m_batchStartGeneration = 0;
+	m_fitnessHistory.clear();
 	addGenerationToGraph();
 
-	if (m_isPopulationUpdating) {
-		m_shouldDiscardFuturePopulation = true;
+	m_isSolved = false;
+	m_runTimer.start();
+	m_metrics.startRun(mostFitIndividual.fitness, m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize));
+	restartSnapshotExport();
+	if (mostFitIndividual.fitness >= m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize)) {
+		recordSolution(0, 0);
 	}
+
+	cancelPopulationUpdate();
 }
 
-Population_t Scene_Algorithm::initPopulation(int populationSize, int gridSize) {
+void Scene_Algorithm::cancelPopulationUpdate() {
+	if (!m_isPopulationUpdating) {
+		return;
+	}
+
+	m_stopSource.request_stop();
+	m_stopSource = std::stop_source();
+	m_shouldDiscardFuturePopulation = true;
+}
+
+Population_t Scene_Algorithm::initPopulation(int populationSize, int gridSize, uint64_t seed) {
 	INPUT_VALIDITY(populationSize > 0);
 	INPUT_VALIDITY(gridSize > 0);
 
 	Population_t population(populationSize);
 
-	for (auto& individual : population) {
-		individual = getRandomGenesIndividual(gridSize);
+	for (size_t i = 0; i < population.size(); i++) {
+		Rng_t rng = getStreamRng(seed, RngStream::Initial, 0, i);
+		population[i] = getRandomGenesIndividual(gridSize, rng);
 	}
 
 	OUTPUT_VALIDITY(population.size() == populationSize);
@@ -86,13 +269,28 @@ Population_t Scene_Algorithm::initPopulation(int populationSize, int gridSize) {
 	return population;
 }
 
-Individual Scene_Algorithm::getRandomGenesIndividual(int gridSize) {
+Rng_t Scene_Algorithm::getStreamRng(uint64_t seed, RngStream stream, int64_t generation, size_t index) noexcept {
+	uint64_t streamHash = MyUtils::mixHash(seed ^ static_cast<uint64_t>(stream));
+	streamHash = MyUtils::mixHash(streamHash ^ static_cast<uint64_t>(generation));
+
+	return Rng_t(MyUtils::mixHash(streamHash ^ static_cast<uint64_t>(index)));
+}
+
+uint64_t Scene_Algorithm::foldTraceChecksum(uint64_t checksum, const Population_t& population) noexcept {
+	for (const auto& individual : population) {
+		checksum = MyUtils::mixHash(checksum ^ static_cast<uint32_t>(individual.fitness));
+	}
+
+	return checksum;
+}
+
+Individual Scene_Algorithm::getRandomGenesIndividual(int gridSize, Rng_t& rng) {
 	INPUT_VALIDITY(gridSize > 0);
 
 	Gene_t gene(gridSize * gridSize);
 
 	for (auto& trait : gene) {
-		trait = getRandomNum(0, gridSize - 1);
+		trait = static_cast<Trait_t>(getRandomNum(0, gridSize - 1, rng));
 	}
 
 	OUTPUT_VALIDITY(gene.size() == gridSize * gridSize);
@@ -100,52 +298,120 @@ Individual Scene_Algorithm::getRandomGenesIndividual(int gridSize) {
 	return Individual(std::move(gene));
 }
 
-int Scene_Algorithm::getRandomNum(int rngStart, int rngEnd) {
+int Scene_Algorithm::getRandomNum(int rngStart, int rngEnd, Rng_t& rng) {
 	INPUT_VALIDITY(rngStart <= rngEnd);
 
-	static std::random_device randDev;
-	static std::mt19937 rng(randDev());
-	std::uniform_int_distribution<std::mt19937::result_type> range(rngStart, rngEnd);
+	// Plain modulo instead of std::uniform_int_distribution, whose output differs between standard libraries
+	uint64_t rangeSize = static_cast<uint64_t>(static_cast<int64_t>(rngEnd) - rngStart) + 1;
 
-	int result = static_cast<int>(range(rng));
+	int result = rngStart + static_cast<int>(rng() % rangeSize);
 
 	OUTPUT_VALIDITY(result >= rngStart && result <= rngEnd);
 
 	return result;
 }
 
-void Scene_Algorithm::evaluatePopulation(Population_t& population, const FitnessFunc_t& fitnessFunc) noexcept {
+void Scene_Algorithm::evaluatePopulation(Population_t& population, const FitnessFunc_t& fitnessFunc, FitnessCache& fitnessCache, std::pmr::memory_resource* scratch) {
 	INPUT_VALIDITY(!population.empty());
 
+	TraceScope traceScope("Evaluate");
+
+	// Cache misses are scored together, so a fitness function is called once per generation instead of once per individual
+	std::pmr::vector<Individual*> uncachedIndividuals(scratch);
 	for (auto& individual : population) {
-		individual.fitness = fitnessFunc(individual);
+		if (individual.isFitnessValid) {
+			continue;
+		}
+
+		std::optional<int> cachedFitness = fitnessCache.find(individual.hash);
+		if (cachedFitness) {
+			individual.fitness = *cachedFitness;
+			individual.isFitnessValid = true;
+		}
+		else {
+			uncachedIndividuals.emplace_back(&individual);
+		}
+	}
+
+	if (uncachedIndividuals.empty()) {
+		return;
+	}
+
+	std::pmr::vector<int> fitness(uncachedIndividuals.size(), scratch);
+	fitnessFunc(uncachedIndividuals, fitness);
+
+	for (size_t i = 0; i < uncachedIndividuals.size(); i++) {
+		Individual& individual = *uncachedIndividuals[i];
+		individual.fitness = fitness[i];
+		individual.isFitnessValid = true;
+		fitnessCache.insert(individual.hash, individual.fitness);
 	}
 }
 
-void Scene_Algorithm::sortMostFitInividual(Population_t& population) {
+FitnessFunc_t Scene_Algorithm::makeFitnessFunc(int (*evaluationFunc)(const Individual& individual)) {
+	INPUT_VALIDITY(evaluationFunc != nullptr);
+
+	return [evaluationFunc](std::span<const Individual* const> individuals, std::span<int> fitness) {
+		for (size_t i = 0; i < individuals.size(); i++) {
+			fitness[i] = evaluationFunc(*individuals[i]);
+		}
+	};
+}
+
+const Individual& Scene_Algorithm::getMostFitIndividual(const Population_t& population) {
 	INPUT_VALIDITY(!population.empty());
 
-	std::ranges::partial_sort(population, population.begin() + 1, [](const auto& individual1, const auto& individual2) {
-		return individual1.fitness > individual2.fitness;
+	return *std::ranges::max_element(population, [](const Individual& individual1, const Individual& individual2) {
+		return individual1.fitness < individual2.fitness;
 	});
 }
 
-void Scene_Algorithm::addGenerationToGraph() {
-	int totalPopulationFitness = getTotalPopulationFitness(m_population);
-	auto [minFitness, maxFitness] = getMinMaxPopulationFitness(m_population);
-	int avgFitness = totalPopulationFitness / m_populationSize;
+void Scene_Algorithm::resizePopulation() {
+	INPUT_VALIDITY(!m_isPopulationUpdating);
+	INPUT_VALIDITY(m_populationSize > 0);
 
-	m_maxFitnessValues[m_curUpdate] = maxFitness;
-	m_minFitnessValues[m_curUpdate] = minFitness;
-	m_avgFitnessValues[m_curUpdate] = avgFitness;
+	size_t prevSize = m_population.size();
+	m_population.resize(m_populationSize);
+
+	for (size_t i = prevSize; i < m_population.size(); i++) {
+		Rng_t rng = getStreamRng(m_seed, RngStream::Initial, m_curGeneration, i);
+		m_population[i] = getRandomGenesIndividual(m_gridSize, rng);
+	}
+	evaluatePopulation(m_population, m_fitnessFunctions[m_curFitnessFuncIndex], *m_fitnessCache);
 
-	m_curUpdate++;
+	OUTPUT_VALIDITY(m_population.size() == m_populationSize);
 }
 
-int Scene_Algorithm::getTotalPopulationFitness(const Population_t& population) {
+void Scene_Algorithm::receiveSnapshot() {
+	if (!m_snapshots.update()) {
+		return;
+	}
+
+	const PopulationSnapshot& snapshot = m_snapshots.read();
+	if (snapshot.runId != m_runId) {
+		return;
+	}
+
+	m_shownSnapshot = snapshot;
+	addGenerationToGraph();
+
+	m_metrics.maxFitness.store(m_shownSnapshot.maxFitness, std::memory_order_relaxed);
+	m_metrics.avgFitness.store(m_shownSnapshot.avgFitness, std::memory_order_relaxed);
+	m_metrics.minFitness.store(m_shownSnapshot.minFitness, std::memory_order_relaxed);
+
+	exportSnapshotIfDue();
+}
+
+void Scene_Algorithm::addGenerationToGraph() {
+	int64_t generation = m_batchStartGeneration + m_shownSnapshot.generationsDone;
+
+	m_fitnessHistory.add(generation, m_shownSnapshot.maxFitness, m_shownSnapshot.minFitness, m_shownSnapshot.avgFitness);
+}
+
+int64_t Scene_Algorithm::getTotalPopulationFitness(const Population_t& population) {
 	INPUT_VALIDITY(!population.empty());
 
-	int sum = 0;
+	int64_t sum = 0;
 
 	for (const auto& individual : population) {
 		sum += individual.fitness;
@@ -177,98 +443,629 @@ float Scene_Algorithm::computeGridPhysicalSize(sf::Vector2u windowSize, float re
 	return result;
 }
 
-void Scene_Algorithm::resizeCell(float relativeDif) {
-	INPUT_VALIDITY(relativeDif > 0);
+void Scene_Algorithm::recordSolution(int64_t generation, int timeMs) {
+	INPUT_VALIDITY(generation >= 0);
+	INPUT_VALIDITY(timeMs >= 0);
+
+	m_isSolved = true;
+	m_solveGeneration = generation;
+	m_solveTimeMs = timeMs;
+	m_metrics.solvedRuns.fetch_add(1, std::memory_order_relaxed);
+
+	std::cout << "Scene_Algorithm: session " << m_sessionNumber << " reached the optimal fitness at generation " << generation << " in " << timeMs << " ms"
+		<< " (seed " << m_seed << ", trace checksum " << std::hex << std::setw(16) << std::setfill('0') << m_traceChecksum << std::dec << ")\n";
+}
+
+int64_t Scene_Algorithm::getFrameTimeUs() const noexcept {
+	int framerateLimit = m_game->getFramerateLimit();
+	if (framerateLimit <= 0) {
+		return FALLBACK_FRAME_TIME_US;
+	}
+
+	return 1'000'000 / framerateLimit;
+}
+
+int64_t Scene_Algorithm::getBatchTimeBudgetUs() const noexcept {
+	if (m_batchTimeBudgetMs > 0) {
+		return static_cast<int64_t>(m_batchTimeBudgetMs) * 1'000;
+	}
+
+	return getFrameTimeUs();
+}
+
+void Scene_Algorithm::adaptGenerationsPerUpdate(int generationsDone, int64_t elapsedUs) {
+	INPUT_VALIDITY(generationsDone > 0);
+	INPUT_VALIDITY(elapsedUs >= 0);
+
+	double usPerGeneration = std::max(1.0, static_cast<double>(elapsedUs) / generationsDone);
+	double fittingGenerations = static_cast<double>(getBatchTimeBudgetUs()) / usPerGeneration;
+	int targetGenerations = static_cast<int>(std::clamp(fittingGenerations, 1.0, static_cast<double>(m_maxGenerationsPerUpdate)));
+
+	m_generationsPerUpdate = std::max(1, (m_generationsPerUpdate + targetGenerations) / 2);
+
+	OUTPUT_VALIDITY(m_generationsPerUpdate > 0 && m_generationsPerUpdate <= m_maxGenerationsPerUpdate);
+}
+
+void Scene_Algorithm::updateMetrics() {
+	bool isCheckpointWriting = m_futureCheckpoint.valid() && m_futureCheckpoint.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+	int64_t sweepJobsQueued = m_sweep.isRunning() ? static_cast<int64_t>(m_sweep.getJobAmount() - m_sweep.getDoneAmount()) : 0;
 
-	m_cell.getComponent<CTransform>().pos *= relativeDif;
+	m_metrics.batchesInFlight.store(m_isPopulationUpdating ? 1 : 0, std::memory_order_relaxed);
+	m_metrics.checkpointsInFlight.store(isCheckpointWriting ? 1 : 0, std::memory_order_relaxed);
+	m_metrics.sweepJobsQueued.store(sweepJobsQueued, std::memory_order_relaxed);
+	m_metrics.snapshotExportsQueued.store(static_cast<int64_t>(m_snapshotExporter.getQueuedAmount()), std::memory_order_relaxed);
+}
+
+void Scene_Algorithm::restartSnapshotExport() {
+	m_hasExportedBest = false;
+	m_nextExportGeneration = m_exportIntervalGenerations > 0 ? (m_curGeneration / m_exportIntervalGenerations + 1) * m_exportIntervalGenerations : 0;
+}
+
+void Scene_Algorithm::exportSnapshotIfDue() {
+	// Snapshots arrive once per frame, so the export happens at the first snapshot at or past the due generation
+	int64_t generation = m_batchStartGeneration + m_shownSnapshot.generationsDone;
+	bool isPeriodicExportDue = m_exportIntervalGenerations > 0 && generation >= m_nextExportGeneration;
+	bool isNewBest = m_shouldExportOnBest && (!m_hasExportedBest || m_shownSnapshot.maxFitness > m_exportedBestFitness);
+	if (!isPeriodicExportDue && !isNewBest) {
+		return;
+	}
+
+	if (isPeriodicExportDue) {
+		m_nextExportGeneration = (generation / m_exportIntervalGenerations + 1) * m_exportIntervalGenerations;
+	}
+	if (isNewBest) {
+		m_exportedBestFitness = m_shownSnapshot.maxFitness;
+		m_hasExportedBest = true;
+	}
+
+	exportSnapshot(generation);
+}
+
+void Scene_Algorithm::exportSnapshot(int64_t generation) {
+	INPUT_VALIDITY(generation >= 0);
+	INPUT_VALIDITY(m_shownSnapshot.bestGene.size() == static_cast<size_t>(m_gridSize) * m_gridSize);
+
+	TraceScope traceScope("Export snapshot");
+
+	sf::Vector2u imageSize(m_exportImageSize, m_exportImageSize);
+	if (m_exportTexture.getSize() != imageSize && !m_exportTexture.create(imageSize.x, imageSize.y)) {
+		std::cerr << "Scene_Algorithm::exportSnapshot: Cannot create render texture, snapshots are not exported\n";
+		m_exportIntervalGenerations = 0;
+		m_shouldExportOnBest = false;
+		return;
+	}
+	if (m_exportGridSize != m_gridSize) {
+		m_exportRenderer.resize(m_gridSize, static_cast<float>(m_exportImageSize));
+		m_exportGridSize = m_gridSize;
+	}
 
-	auto& cellSh = m_cell.getComponent<CShape>().shape;
-	cellSh.setSize(cellSh.getSize() * relativeDif);
-	cellSh.setOrigin(cellSh.getSize() / 2.F);
+	// Only drawing and the texture readback happen here, encoding and disk writes are left to the exporter thread
+	m_exportRenderer.update(m_shownSnapshot.bestGene, m_shownSnapshot.colorGene, getColorShare());
+	m_exportTexture.clear(sf::Color::White);
+	m_exportRenderer.draw(m_exportTexture);
+	m_exportTexture.display();
 
-	auto& cellText = m_cell.getComponent<CText>();
-	cellText.text.setScale(cellText.text.getScale() * relativeDif);
-	cellText.containerSize *= relativeDif;
+	std::ostringstream path;
+	path << m_exportDirectory << '/' << m_seed << '_' << m_fitnessFuncNames[m_curFitnessFuncIndex] << "_gen" << std::setw(8) << std::setfill('0') << generation
+		<< "_fitness" << m_shownSnapshot.maxFitness << ".png";
+	m_snapshotExporter.push(m_exportTexture.getTexture().copyToImage(), path.str());
+}
+
+float Scene_Algorithm::getColorShare() const noexcept {
+	return 255 / (m_gridSize * m_colorWeights[m_curFitnessFuncIndex]);
+}
+
+void Scene_Algorithm::saveCheckpoint() {
+	INPUT_VALIDITY(!m_isPopulationUpdating);
+
+	m_isCheckpointRequested = false;
+	m_checkpointTimer.start();
+
+	// A slow disk only delays the next checkpoint, the GA never waits for a write
+	if (m_futureCheckpoint.valid() && m_futureCheckpoint.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return;
+	}
+
+	m_futureCheckpoint = std::async(std::launch::async, &Checkpoint::save, m_checkpointPath, captureCheckpoint());
+}
+
+CheckpointData Scene_Algorithm::captureCheckpoint() const {
+	INPUT_VALIDITY(!m_isPopulationUpdating);
+	INPUT_VALIDITY(!m_population.empty());
+
+	CheckpointData data;
+	data.gridSize          = m_gridSize;
+	data.populationSize    = static_cast<int>(m_population.size());
+	data.fitnessFuncName   = m_fitnessFuncNames[m_curFitnessFuncIndex];
+	data.mutationRate      = m_parameters.mutationRate;
+	data.randomGenesRate   = m_parameters.randomGenesRate;
+	data.eliteSurvivalRate = m_parameters.eliteSurvivalRate;
+	data.shouldReplaceDuplicates = m_parameters.shouldReplaceDuplicates;
+	data.crossoverType     = static_cast<int>(m_parameters.crossoverType.load());
+	data.steadyStateChildAmount = m_parameters.isSteadyState ? m_parameters.steadyStateChildAmount.load() : 0;
+	data.generation        = m_curGeneration;
+	data.runTimeMs         = m_isSolved ? m_solveTimeMs : m_runTimer.timeElapsed();
+
+	data.genes.reserve(m_population.size() * m_gridSize * m_gridSize);
+	data.fitness.reserve(m_population.size());
+	for (const auto& individual : m_population) {
+		data.genes.insert(data.genes.end(), individual.gene.begin(), individual.gene.end());
+		data.fitness.emplace_back(individual.fitness);
+	}
+
+	data.history = m_fitnessHistory.getSamples();
+	data.historyArchiveSize = m_fitnessHistory.getArchiveSize();
+	data.historyBucketWidth = m_fitnessHistory.getBucketWidth();
+	data.historyTotalSize   = m_fitnessHistory.size();
+
+	data.seed = m_seed;
+	data.traceChecksum = m_traceChecksum;
+
+	OUTPUT_VALIDITY(data.genes.size() == m_population.size() * m_gridSize * m_gridSize);
+
+	return data;
+}
+
+bool Scene_Algorithm::loadCheckpoint() {
+	std::optional<CheckpointData> data = Checkpoint::load(m_checkpointPath);
+	if (!data) {
+		return false;
+	}
+
+	auto fitnessFuncName = std::ranges::find(m_fitnessFuncNames, data->fitnessFuncName);
+	if (fitnessFuncName == m_fitnessFuncNames.end()) {
+		std::cerr << "Scene_Algorithm::loadCheckpoint: Checkpoint with path \"" << m_checkpointPath << "\" uses the fitness function \"" << data->fitnessFuncName << "\", which is not loaded\n";
+		return false;
+	}
+
+	int boxSize = static_cast<int>(std::sqrt(data->gridSize));
+	bool areTraitsValid = std::ranges::all_of(data->genes, [gridSize = data->gridSize](uint8_t trait) { return trait < gridSize; });
+	if (data->gridSize != boxSize * boxSize || data->gridSize > MAX_GRID_SIZE || !areTraitsValid
+		|| data->mutationRate < 0 || data->mutationRate > 100 || data->randomGenesRate < 0 || data->randomGenesRate > 100
+		|| data->eliteSurvivalRate < 0 || data->eliteSurvivalRate > 100 || data->crossoverType < 0 || data->crossoverType >= CROSSOVER_TYPE_AMOUNT || data->steadyStateChildAmount < 0 || data->generation < 0 || data->runTimeMs < 0) {
+		std::cerr << "Scene_Algorithm::loadCheckpoint: Checkpoint with path \"" << m_checkpointPath << "\" holds invalid parameters\n";
+		return false;
+	}
+
+	if (!m_fitnessHistory.restore(data->history.data(), data->history.size(), data->historyArchiveSize, data->historyBucketWidth, data->historyTotalSize)) {
+		return false;
+	}
+
+	cancelPopulationUpdate();
+
+	m_gridSize = data->gridSize;
+	m_populationSize = data->populationSize;
+	m_curFitnessFuncIndex = static_cast<int>(fitnessFuncName - m_fitnessFuncNames.begin());
+	m_parameters.mutationRate = data->mutationRate;
+	m_parameters.randomGenesRate = data->randomGenesRate;
+	m_parameters.eliteSurvivalRate = data->eliteSurvivalRate;
+	m_parameters.shouldReplaceDuplicates = data->shouldReplaceDuplicates;
+	m_parameters.crossoverType = static_cast<CrossoverType>(data->crossoverType);
+	m_parameters.isSteadyState = data->steadyStateChildAmount > 0;
+	if (data->steadyStateChildAmount > 0) {
+		m_parameters.steadyStateChildAmount = data->steadyStateChildAmount;
+	}
+	m_seed = data->seed;
+	m_traceChecksum = data->traceChecksum;
+
+	size_t geneSize = static_cast<size_t>(m_gridSize) * m_gridSize;
+	m_population.clear();
+	m_population.reserve(m_populationSize);
+	for (size_t i = 0; i < m_populationSize; i++) {
+		auto geneStart = data->genes.begin() + i * geneSize;
+		Individual individual(Gene_t(geneStart, geneStart + geneSize));
+		individual.fitness = data->fitness[i];
+		individual.isFitnessValid = true;
+		m_population.emplace_back(std::move(individual));
+	}
+	m_fitnessCache = std::make_shared<FitnessCache>(m_fitnessCacheCapacity);
+
+	const Individual& mostFitIndividual = getMostFitIndividual(m_population);
+	m_colorGene = m_colorFunctions[m_curFitnessFuncIndex](mostFitIndividual);
+	m_bestHash = mostFitIndividual.hash;
+
+	m_runId++;
+	fillSnapshot(m_shownSnapshot, m_population, mostFitIndividual, m_colorGene, 0, m_runId);
+
+	m_curGeneration = data->generation;
+	m_batchStartGeneration = m_curGeneration;
+
+	m_isSolved = false;
+	m_runTimer.start(data->runTimeMs);
+	m_metrics.startRun(mostFitIndividual.fitness, m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize));
+	restartSnapshotExport();
+	if (mostFitIndividual.fitness >= m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize)) {
+		recordSolution(m_curGeneration, data->runTimeMs);
+	}
+
+	m_gridRenderer.resize(m_gridSize, m_gridPhysicalSize);
+	syncControlValues();
+
+	OUTPUT_VALIDITY(m_population.size() == m_populationSize);
+
+	return true;
+}
+
+void Scene_Algorithm::launchPopulationUpdate() {
+	INPUT_VALIDITY(!m_isPopulationUpdating);
+
+	if (m_population.size() != m_populationSize) {
+		resizePopulation();
+	}
+
+	PopulationBatch batch;
+	batch.population = std::move(m_population);
+	batch.colorGene = std::move(m_colorGene);
+	batch.seed = m_seed;
+	batch.traceChecksum = m_traceChecksum;
+	batch.bestHash = m_bestHash;
+	batch.startGeneration = m_curGeneration;
+	batch.threadName = BATCH_THREAD_NAMES[m_sessionNumber - 1];
+	batch.cpu = m_threadPlacement.getCpu(m_sessionNumber - 1);
+
+	m_isPopulationUpdating = true;
+	m_batchStartTimeMs = m_runTimer.timeElapsed();
+	m_batchStartTimeUs = m_runTimer.timeElapsedUs();
+	m_batchStartGeneration = m_curGeneration;
+	m_batchStartEvaluations = m_metrics.evaluations.load(std::memory_order_relaxed);
+	m_futurePopulation = std::async(std::launch::async, &Scene_Algorithm::updatePopulation, std::move(batch), m_gridSize, std::cref(m_parameters),
+									m_generationsPerUpdate, getBatchTimeBudgetUs(), getFrameTimeUs(), std::ref(m_fitnessFunctions[m_curFitnessFuncIndex]),
+									m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize), m_fitnessCache, std::ref(m_colorFunctions[m_curFitnessFuncIndex]),
+									std::ref(m_snapshots), std::ref(m_metrics), std::ref(m_generationArena), m_runId, m_stopSource.get_token());
+}
+
+PopulationBatch Scene_Algorithm::updatePopulation(PopulationBatch batch, int gridSize, const GeneticParameters& parameters, int generationsPerUpdate, int64_t timeBudgetUs, int64_t publishIntervalUs, const FitnessFunc_t& fitnessFunc, int optimalFitness, std::shared_ptr<FitnessCache> fitnessCache, const ColorFunc_t& colorFunc, SnapshotBuffer_t& snapshots, GaMetrics& metrics, GenerationArena& arena, int runId, std::stop_token stopToken) {
+	INPUT_VALIDITY(!batch.population.empty());
+	INPUT_VALIDITY(gridSize > 0);
+	INPUT_VALIDITY(batch.population[0].gene.size() == gridSize * gridSize);
+	INPUT_VALIDITY(generationsPerUpdate > 0);
+	INPUT_VALIDITY(timeBudgetUs > 0);
+	INPUT_VALIDITY(publishIntervalUs > 0);
+	INPUT_VALIDITY(optimalFitness >= 0);
+	INPUT_VALIDITY(fitnessCache != nullptr);
+
+	// In generational mode every generation allocates its population on this thread, so once pinned the population moves
+	// to the local NUMA node. Steady state keeps the population allocated by reset() on the main thread.
+	ScopedThreadPin threadPin(batch.cpu);
+	Tracer::setThreadName(batch.threadName);
+
+	Timer timer;
+	int64_t nextPublishUs = publishIntervalUs;
+	batch.generationsDone = 0;
+	std::optional<SteadyStateIndex> steadyState;
+	FitnessFunc_t countedFitnessFunc = [&fitnessFunc, &metrics](std::span<const Individual* const> individuals, std::span<int> fitness) {
+		metrics.evaluations.fetch_add(individuals.size(), std::memory_order_relaxed);
+		fitnessFunc(individuals, fitness);
+	};
+
+	for (int i = 0; i < generationsPerUpdate; i++) {
+		if (stopToken.stop_requested()) {
+			return batch;
+		}
+		arena.reset();
+		TraceScope traceScope("Generation");
+
+		int mutationRate = parameters.mutationRate.load(std::memory_order_relaxed);
+		int randomGenesRate = parameters.randomGenesRate.load(std::memory_order_relaxed);
+		int eliteSurvivalRate = parameters.eliteSurvivalRate.load(std::memory_order_relaxed);
+		CrossoverType crossoverType = parameters.crossoverType.load(std::memory_order_relaxed);
+
+		bool shouldReplaceDuplicates = parameters.shouldReplaceDuplicates.load(std::memory_order_relaxed);
+
+		int64_t generation = batch.startGeneration + batch.generationsDone + 1;
+
+		int maxFitness = 0;
+		if (parameters.isSteadyState.load(std::memory_order_relaxed)) {
+			if (!steadyState) {
+				steadyState = buildSteadyStateIndex(batch.population);
+			}
+			int childAmount = parameters.steadyStateChildAmount.load(std::memory_order_relaxed);
+			maxFitness = steadyStateOperations(batch.population, *steadyState, gridSize, childAmount, mutationRate, randomGenesRate, crossoverType, shouldReplaceDuplicates,
+											   countedFitnessFunc, *fitnessCache, batch.seed, generation, batch.traceChecksum, &arena);
+		}
+		else {
+			steadyState.reset();
+			batch.population = geneticAlgorithmOperations(batch.population, gridSize, mutationRate, randomGenesRate, eliteSurvivalRate, crossoverType, batch.seed, generation, &arena);
+			if (shouldReplaceDuplicates) {
+				replaceDuplicates(batch.population, gridSize, batch.seed, generation, &arena);
+			}
+			evaluatePopulation(batch.population, countedFitnessFunc, *fitnessCache, &arena);
+			batch.traceChecksum = foldTraceChecksum(batch.traceChecksum, batch.population);
+			maxFitness = getMinMaxPopulationFitness(batch.population).second;
+		}
+		batch.generationsDone++;
+		metrics.recordGeneration(maxFitness, arena.getUsedBytes(), arena.getOverflowAmount());
+
+		if (maxFitness >= optimalFitness) {
+			batch.isSolved = true;
+			batch.solveTimeMs = timer.timeElapsed();
+			break;
+		}
+
+		// The steady state heap refers to individuals by index, so their order has to stay put
+		if (!steadyState) {
+			shufflePopulation(batch.population, batch.seed, generation);
+		}
+
+		int64_t elapsedUs = timer.timeElapsedUs();
+		if (elapsedUs >= timeBudgetUs) {
+			break;
+		}
+		if (elapsedUs >= nextPublishUs) {
+			publishSnapshot(batch, colorFunc, snapshots, runId);
+			nextPublishUs = elapsedUs + publishIntervalUs;
+		}
+	}
+	batch.elapsedUs = timer.timeElapsedUs();
+	metrics.batchBusyUs.fetch_add(batch.elapsedUs, std::memory_order_relaxed);
+
+	publishSnapshot(batch, colorFunc, snapshots, runId);
+
+	OUTPUT_VALIDITY(batch.generationsDone > 0 && batch.generationsDone <= generationsPerUpdate);
+	OUTPUT_VALIDITY(batch.colorGene.size() == batch.population[0].gene.size());
+
+	return batch;
+}
+
+SweepRunResult Scene_Algorithm::runSweepJob(const SweepConfig& config, uint64_t seed, int gridSize, const FitnessFunc_t& fitnessFunc, int optimalFitness, bool shouldReplaceDuplicates, bool isSteadyState, int steadyStateChildAmount, int maxGenerations, int timeLimitMs, size_t fitnessCacheCapacity, GenerationArena& arena, std::stop_token stopToken) {
+	INPUT_VALIDITY(config.populationSize > 0);
+	INPUT_VALIDITY(gridSize > 0);
+	INPUT_VALIDITY(optimalFitness >= 0);
+	INPUT_VALIDITY(maxGenerations > 0);
+	INPUT_VALIDITY(timeLimitMs > 0);
+
+	TraceScope traceScope("Sweep run");
+
+	Timer timer;
+	FitnessCache fitnessCache(fitnessCacheCapacity);
+	Population_t population = initPopulation(config.populationSize, gridSize, seed);
+	evaluatePopulation(population, fitnessFunc, fitnessCache);
+
+	SweepRunResult result;
+	result.bestFitness = getMinMaxPopulationFitness(population).second;
+	int64_t timeLimitUs = static_cast<int64_t>(timeLimitMs) * 1'000;
+
+	std::optional<SteadyStateIndex> steadyState;
+	uint64_t traceChecksum = 0;
+	if (isSteadyState) {
+		steadyState = buildSteadyStateIndex(population);
+	}
+
+	while (result.generations < maxGenerations && result.bestFitness < optimalFitness && !stopToken.stop_requested()) {
+		int generation = ++result.generations;
+		arena.reset();
+
+		int maxFitness = 0;
+		if (steadyState) {
+			maxFitness = steadyStateOperations(population, *steadyState, gridSize, steadyStateChildAmount, config.mutationRate, config.randomGenesRate, config.crossoverType,
+											   shouldReplaceDuplicates, fitnessFunc, fitnessCache, seed, generation, traceChecksum, &arena);
+		}
+		else {
+			population = geneticAlgorithmOperations(population, gridSize, config.mutationRate, config.randomGenesRate, config.eliteSurvivalRate, config.crossoverType, seed, generation, &arena);
+			if (shouldReplaceDuplicates) {
+				replaceDuplicates(population, gridSize, seed, generation, &arena);
+			}
+			evaluatePopulation(population, fitnessFunc, fitnessCache, &arena);
+			maxFitness = getMinMaxPopulationFitness(population).second;
+		}
+
+		int64_t elapsedUs = timer.timeElapsedUs();
+		if (maxFitness > result.bestFitness) {
+			result.bestFitness = maxFitness;
+			result.generationOfBest = generation;
+			result.timeToBestMs = elapsedUs / 1'000.0;
+		}
+		if (elapsedUs >= timeLimitUs) {
+			break;
+		}
+
+		if (!steadyState) {
+			shufflePopulation(population, seed, generation);
+		}
+	}
+
+	int64_t runTimeUs = std::max<int64_t>(1, timer.timeElapsedUs());
+	result.finalFitness = getMinMaxPopulationFitness(population).second;
+	result.isSolved = result.bestFitness >= optimalFitness;
+	result.runTimeMs = runTimeUs / 1'000.0;
+	result.generationsPerSec = result.generations * 1'000'000.0 / runTimeUs;
+
+	return result;
+}
+
+void Scene_Algorithm::startSweep() {
+	INPUT_VALIDITY(!m_sweep.isRunning());
+
+	m_sweepSettings.firstWorkerIndex = m_gaThreadAmount;
+	m_sweep.start(m_sweepSettings, [gridSize = m_gridSize, fitnessFunc = m_fitnessFunctions[m_curFitnessFuncIndex],
+		optimalFitness = m_optimalFunctions[m_curFitnessFuncIndex](m_gridSize), shouldReplaceDuplicates = m_parameters.shouldReplaceDuplicates.load(),
+		isSteadyState = m_parameters.isSteadyState.load(), steadyStateChildAmount = m_parameters.steadyStateChildAmount.load(),
+		maxGenerations = m_sweepSettings.maxGenerations, timeLimitMs = m_sweepSettings.timeLimitMs, fitnessCacheCapacity = m_fitnessCacheCapacity]
+		(const SweepConfig& config, uint64_t seed, GenerationArena& arena, std::stop_token stopToken) -> SweepRunResult {
+			return runSweepJob(config, seed, gridSize, fitnessFunc, optimalFitness, shouldReplaceDuplicates, isSteadyState, steadyStateChildAmount, maxGenerations, timeLimitMs, fitnessCacheCapacity, arena, stopToken);
+		});
+}
+
+void Scene_Algorithm::publishSnapshot(PopulationBatch& batch, const ColorFunc_t& colorFunc, SnapshotBuffer_t& snapshots, int runId) {
+	INPUT_VALIDITY(!batch.population.empty());
+
+	TraceScope traceScope("Publish snapshot");
+
+	const Individual& mostFitIndividual = getMostFitIndividual(batch.population);
+	if (mostFitIndividual.hash != batch.bestHash || batch.colorGene.empty()) {
+		batch.colorGene = colorFunc(mostFitIndividual);
+		batch.bestHash = mostFitIndividual.hash;
+	}
+
+	fillSnapshot(snapshots.getWriteBuffer(), batch.population, mostFitIndividual, batch.colorGene, batch.generationsDone, runId);
+	snapshots.publish();
+}
+
+void Scene_Algorithm::fillSnapshot(PopulationSnapshot& snapshot, const Population_t& population, const Individual& mostFitIndividual, const Gene_t& colorGene, int generationsDone, int runId) {
+	INPUT_VALIDITY(!population.empty());
+	INPUT_VALIDITY(colorGene.size() == mostFitIndividual.gene.size());
+	INPUT_VALIDITY(generationsDone >= 0);
+
+	auto [minFitness, maxFitness] = getMinMaxPopulationFitness(population);
+
+	snapshot.bestGene = mostFitIndividual.gene;
+	snapshot.colorGene = colorGene;
+	snapshot.runId = runId;
+	snapshot.generationsDone = generationsDone;
+	snapshot.maxFitness = maxFitness;
+	snapshot.minFitness = minFitness;
+	snapshot.avgFitness = static_cast<int>(getTotalPopulationFitness(population) / static_cast<int64_t>(population.size()));
+}
+
+Population_t Scene_Algorithm::geneticAlgorithmOperations(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate, CrossoverType crossoverType, uint64_t seed, int64_t generation, std::pmr::memory_resource* scratch) {
+	INPUT_VALIDITY(!population.empty());
+	INPUT_VALIDITY(gridSize > 0);
+	INPUT_VALIDITY(population[0].gene.size() == gridSize * gridSize);
+	INPUT_VALIDITY(mutationRate >= 0 && mutationRate <= 100);
+	INPUT_VALIDITY(randomGenesRate >= 0 && randomGenesRate <= 100);
+	INPUT_VALIDITY(eliteSurvivalRate >= 0 && eliteSurvivalRate <= 100);
+
+	TraceScope traceScope("Genetic operations");
+
+	Population_t newPopulation(population.size());
+
+	int recombinationRate = std::max(0, 100 - mutationRate - randomGenesRate);
+	int64_t totalPopulationFitness = getTotalPopulationFitness(population);
+
+	std::pmr::vector<int> eliteIndividualsIndices = getEliteIndividualsIndices(population, eliteSurvivalRate, scratch);
+	size_t eliteAmount = eliteIndividualsIndices.size();
+	for (size_t i = 0; i < eliteAmount; i++) {
+		newPopulation[i] = population[eliteIndividualsIndices[i]];
+	}
+
+	// Every slot draws from its own (seed, generation, slot) stream and reads only the previous population,
+	// so the result does not depend on the order or the thread the slots are filled on
+	for (size_t i = eliteAmount; i < newPopulation.size(); i++) {
+		Rng_t rng = getStreamRng(seed, RngStream::Offspring, generation, i);
+		newPopulation[i] = createOffspring(population, gridSize, mutationRate, randomGenesRate, recombinationRate, crossoverType, totalPopulationFitness, rng);
+	}
+
+	OUTPUT_VALIDITY(newPopulation.size() == population.size());
+	OUTPUT_VALIDITY(newPopulation[0].gene.size() == population[0].gene.size());
+
+	return newPopulation;
+}
+
+Individual Scene_Algorithm::createOffspring(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int recombinationRate, CrossoverType crossoverType, int64_t totalPopulationFitness, Rng_t& rng) {
+	INPUT_VALIDITY(!population.empty());
+	INPUT_VALIDITY(gridSize > 0);
+
+	GeneticOperation operation = selectGeneticOperation(mutationRate, randomGenesRate, recombinationRate, rng);
+
+	if (operation == GeneticOperation::Mutation) {
+		int pickedIndex = rouletteIndexSelect(population, totalPopulationFitness, rng);
+		Individual mutant = population[pickedIndex];
+		int randomTraitIndex = getRandomNum(0, static_cast<int>(mutant.gene.size()) - 1, rng);
+		mutant.setTrait(randomTraitIndex, static_cast<Trait_t>(getRandomNum(0, gridSize - 1, rng)));
+		return mutant;
+	}
+	else if (operation == GeneticOperation::RandomGenes) {
+		return getRandomGenesIndividual(gridSize, rng);
+	}
+	else {
+		int pickedIndex1 = rouletteIndexSelect(population, totalPopulationFitness, rng);
+		int pickedIndex2 = rouletteIndexSelect(population, totalPopulationFitness, rng);
+		std::array<Individual, 2> recombinedIndividuals = recombineIndividuals(population[pickedIndex1], population[pickedIndex2], crossoverType, rng);
+		return std::move(recombinedIndividuals[getRandomNum(0, 1, rng)]);
+	}
 }
 
-Population_t Scene_Algorithm::updatePopulation(Population_t population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate, int generationsPerUpdate, int framerateLimit, const FitnessFunc_t& fitnessFunc) {
+SteadyStateIndex Scene_Algorithm::buildSteadyStateIndex(const Population_t& population) {
 	INPUT_VALIDITY(!population.empty());
-	INPUT_VALIDITY(gridSize > 0);
-	INPUT_VALIDITY(population[0].gene.size() == gridSize * gridSize);
-	INPUT_VALIDITY(mutationRate >= 0 && mutationRate <= 100);
-	INPUT_VALIDITY(randomGenesRate >= 0 && randomGenesRate <= 100);
-	INPUT_VALIDITY(eliteSurvivalRate >= 0 && eliteSurvivalRate <= 100);
-	INPUT_VALIDITY(generationsPerUpdate > 0);
-	INPUT_VALIDITY(framerateLimit > 0);
-	
-	for (int i = 0; i < generationsPerUpdate; i++) {
-		population = geneticAlgorithmOperations(population, gridSize, mutationRate, randomGenesRate, eliteSurvivalRate);
-		evaluatePopulation(population, fitnessFunc);
-		shufflePopulation(population);
+
+	SteadyStateIndex result;
+	std::vector<std::pair<int, int>> entries;
+	entries.reserve(population.size());
+	result.hashes.reserve(population.size());
+
+	for (size_t i = 0; i < population.size(); i++) {
+		entries.emplace_back(population[i].fitness, static_cast<int>(i));
+		result.hashes.insert(population[i].hash);
+		result.totalFitness += population[i].fitness;
 	}
+	result.worstHeap = WorstHeap_t(std::greater<>(), std::move(entries));
 
-	return population;
+	OUTPUT_VALIDITY(result.worstHeap.size() == population.size());
+
+	return result;
 }
 
-Population_t Scene_Algorithm::geneticAlgorithmOperations(const Population_t& population, int gridSize, int mutationRate, int randomGenesRate, int eliteSurvivalRate) {
+int Scene_Algorithm::steadyStateOperations(Population_t& population, SteadyStateIndex& steadyState, int gridSize, int childAmount, int mutationRate, int randomGenesRate, CrossoverType crossoverType, bool shouldReplaceDuplicates, const FitnessFunc_t& fitnessFunc, FitnessCache& fitnessCache, uint64_t seed, int64_t generation, uint64_t& traceChecksum, std::pmr::memory_resource* scratch) {
 	INPUT_VALIDITY(!population.empty());
 	INPUT_VALIDITY(gridSize > 0);
-	INPUT_VALIDITY(population[0].gene.size() == gridSize * gridSize);
-	INPUT_VALIDITY(mutationRate >= 0 && mutationRate <= 100);
-	INPUT_VALIDITY(randomGenesRate >= 0 && randomGenesRate <= 100);
-	INPUT_VALIDITY(eliteSurvivalRate >= 0 && eliteSurvivalRate <= 100);
+	INPUT_VALIDITY(childAmount > 0);
+	INPUT_VALIDITY(steadyState.worstHeap.size() == population.size());
 
-	Population_t newPopulation;
-	newPopulation.reserve(population.size());
-
-	int recombinationRate = std::max(0, 100 - mutationRate - randomGenesRate);
-	int totalPopulationFitness = getTotalPopulationFitness(population);
+	TraceScope traceScope("Steady state step");
 
-	std::vector<int> eliteIndividualsIndices = getEliteIndividualsIndices(population, eliteSurvivalRate);
-	for (auto& index : eliteIndividualsIndices) {
-		newPopulation.emplace_back(population[index]);
+	// At least one slot is never replaced, so the best individual survives whatever amount the slider, a checkpoint or
+	// a smaller population left behind. A population of one has nothing to replace.
+	size_t childLimit = std::min<size_t>(childAmount, population.size() - 1);
+	if (childLimit == 0) {
+		return population[0].fitness;
 	}
 
-	while (newPopulation.size() < population.size()) {
-		GeneticOperation operation = selectGeneticOperation(mutationRate, randomGenesRate, recombinationRate);
+	int recombinationRate = std::max(0, 100 - mutationRate - randomGenesRate);
 
-		if (operation == GeneticOperation::Mutation) {
-			int pickedIndex = rouletteIndexSelect(population, getRandomNum(0, totalPopulationFitness));
-			newPopulation.emplace_back(population[pickedIndex]);
-			int randomTraitIndex = getRandomNum(0, static_cast<int>(newPopulation.back().gene.size()) - 1);
-			newPopulation.back().gene[randomTraitIndex] = getRandomNum(0, gridSize - 1);
-		}
-		else if (operation == GeneticOperation::RandomGenes) {
-			newPopulation.emplace_back(getRandomGenesIndividual(gridSize));
-		}
-		else if (operation == GeneticOperation::Recombination) {
-			int pickedIndex1 = rouletteIndexSelect(population, getRandomNum(0, totalPopulationFitness - 1));
-			int pickedIndex2 = rouletteIndexSelect(population, getRandomNum(0, totalPopulationFitness - 1));
-			std::array<Individual, 2> recombinedIndividuals = recombineIndividuals(population[pickedIndex1], population[pickedIndex2]);
-			newPopulation.emplace_back(std::move(recombinedIndividuals[0]));
+	// Parents are picked from the population as it was before this step, so every child keeps its own stream
+	Population_t children(childLimit);
+	for (size_t i = 0; i < children.size(); i++) {
+		Rng_t rng = getStreamRng(seed, RngStream::Offspring, generation, i);
+		children[i] = createOffspring(population, gridSize, mutationRate, randomGenesRate, recombinationRate, crossoverType, steadyState.totalFitness, rng);
+	}
 
-			if (newPopulation.size() < population.size()) {
-				newPopulation.emplace_back(std::move(recombinedIndividuals[1]));
+	if (shouldReplaceDuplicates) {
+		std::pmr::unordered_set<uint64_t> childHashes(scratch);
+		for (size_t i = 0; i < children.size(); i++) {
+			if (steadyState.hashes.contains(children[i].hash) || !childHashes.insert(children[i].hash).second) {
+				Rng_t rng = getStreamRng(seed, RngStream::Duplicates, generation, i);
+				children[i] = getRandomGenesIndividual(gridSize, rng);
+				childHashes.insert(children[i].hash);
 			}
 		}
 	}
 
-	OUTPUT_VALIDITY(newPopulation.size() == population.size());
-	OUTPUT_VALIDITY(newPopulation[0].gene.size() == population[0].gene.size());
+	evaluatePopulation(children, fitnessFunc, fitnessCache, scratch);
+	traceChecksum = foldTraceChecksum(traceChecksum, children);
+	int bestChildFitness = std::ranges::max_element(children, {}, &Individual::fitness)->fitness;
 
-	return newPopulation;
+	// All slots are taken before any child is inserted, so a weak child cannot evict a sibling of the same step
+	std::pmr::vector<int> slots(children.size(), scratch);
+	for (auto& slot : slots) {
+		slot = steadyState.worstHeap.top().second;
+		steadyState.worstHeap.pop();
+	}
+
+	for (size_t i = 0; i < children.size(); i++) {
+		Individual& replaced = population[slots[i]];
+		steadyState.hashes.erase(steadyState.hashes.find(replaced.hash));
+		steadyState.totalFitness += children[i].fitness - replaced.fitness;
+
+		replaced = std::move(children[i]);
+		steadyState.hashes.insert(replaced.hash);
+		steadyState.worstHeap.emplace(replaced.fitness, slots[i]);
+	}
+
+	OUTPUT_VALIDITY(steadyState.worstHeap.size() == population.size());
+
+	return bestChildFitness;
 }
 
-std::vector<int> Scene_Algorithm::getEliteIndividualsIndices(const Population_t& population, int eliteSurvivalRate) {
+std::pmr::vector<int> Scene_Algorithm::getEliteIndividualsIndices(const Population_t& population, int eliteSurvivalRate, std::pmr::memory_resource* scratch) {
 	INPUT_VALIDITY(!population.empty());
 	INPUT_VALIDITY(eliteSurvivalRate >= 0);
 
 	int populationSize = static_cast<int>(population.size());
 	int eliteAmount = getPercentageValue(populationSize, eliteSurvivalRate);
-	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> eliteIndividuals;
+	std::priority_queue<std::pair<int, int>, std::pmr::vector<std::pair<int, int>>, std::greater<>> eliteIndividuals{ std::greater<>(), std::pmr::vector<std::pair<int, int>>(scratch) };
 
 	if (eliteAmount == 0) {
-		return {};
+		return std::pmr::vector<int>(scratch);
 	}
 
 	for (int i = 0; i < populationSize; i++) {
@@ -281,7 +1078,7 @@ std::vector<int> Scene_Algorithm::getEliteIndividualsIndices(const Population_t&
 		}
 	}
 
-	std::vector<int> result(eliteAmount);
+	std::pmr::vector<int> result(eliteAmount, scratch);
 
 	for (int& index : result) {
 		index = eliteIndividuals.top().second;
@@ -307,13 +1104,13 @@ int Scene_Algorithm::getPercentageValue(int totalSize, int percentage) noexcept
 	return result;
 }
 
-GeneticOperation Scene_Algorithm::selectGeneticOperation(int mutationRate, int randomGenesRate, int recombinationRate) {
+GeneticOperation Scene_Algorithm::selectGeneticOperation(int mutationRate, int randomGenesRate, int recombinationRate, Rng_t& rng) {
 	INPUT_VALIDITY(mutationRate >= 0 && mutationRate <= 100);
 	INPUT_VALIDITY(randomGenesRate >= 0 && randomGenesRate <= 100);
 	INPUT_VALIDITY(recombinationRate >= 0 && recombinationRate <= 100);
 
 	int sum = mutationRate + randomGenesRate + recombinationRate;
-	int randomNum = getRandomNum(0, sum - 1);
+	int randomNum = getRandomNum(0, sum - 1, rng);
 
 	if (randomNum < mutationRate) {
 		return GeneticOperation::Mutation;
@@ -326,11 +1123,15 @@ GeneticOperation Scene_Algorithm::selectGeneticOperation(int mutationRate, int r
 	}
 }
 
-int Scene_Algorithm::rouletteIndexSelect(const Population_t& population, int pickValue) noexcept {
+int Scene_Algorithm::rouletteIndexSelect(const Population_t& population, int64_t totalPopulationFitness, Rng_t& rng) {
 	INPUT_VALIDITY(!population.empty());
-	INPUT_VALIDITY(pickValue >= 0);
 
-	int sum = 0;
+	if (totalPopulationFitness <= 0) {
+		return getRandomNum(0, static_cast<int>(population.size()) - 1, rng);
+	}
+
+	int64_t pickValue = static_cast<int64_t>(rng() % static_cast<uint64_t>(totalPopulationFitness));
+	int64_t sum = 0;
 	for (int i = 0; i < population.size(); i++) {
 		sum += population[i].fitness;
 		if (sum > pickValue) {
@@ -338,18 +1139,73 @@ int Scene_Algorithm::rouletteIndexSelect(const Population_t& population, int pic
 		}
 	}
 
-	return population.size() - 1;
+	return static_cast<int>(population.size()) - 1;
 }
 
-std::array<Individual, 2> Scene_Algorithm::recombineIndividuals(const Individual& individual1, const Individual& individual2) {
+std::array<Individual, 2> Scene_Algorithm::recombineIndividuals(const Individual& individual1, const Individual& individual2, CrossoverType crossoverType, Rng_t& rng) {
 	INPUT_VALIDITY(!individual1.gene.empty());
 	INPUT_VALIDITY(!individual2.gene.empty());
 	INPUT_VALIDITY(individual1.gene.size() == individual2.gene.size());
 
 	std::array<Individual, 2> result = { individual1, individual2 };
-	int slicePoint = getRandomNum(0, static_cast<int>(individual1.gene.size()) / 2);
+	size_t geneSize = result[0].gene.size();
+	size_t gridSize = static_cast<size_t>(std::lround(std::sqrt(geneSize)));
+	size_t boxSize  = static_cast<size_t>(std::lround(std::sqrt(gridSize)));
+
+	uint64_t hashDelta = 0;
+	switch (crossoverType) {
+	case CrossoverType::SinglePoint: {
+		size_t slicePoint = getRandomNum(0, static_cast<int>(geneSize) / 2, rng);
+		swapTraitRange(result, slicePoint, geneSize, hashDelta);
+		break;
+	}
+	case CrossoverType::Uniform:
+		uniformCrossover(result, rng, hashDelta);
+		break;
+	case CrossoverType::TwoPoint: {
+		size_t point1 = getRandomNum(0, static_cast<int>(geneSize), rng);
+		size_t point2 = getRandomNum(0, static_cast<int>(geneSize), rng);
+		swapTraitRange(result, std::min(point1, point2), std::max(point1, point2), hashDelta);
+		break;
+	}
+	case CrossoverType::RowBlock: {
+		// Whole rows keep their row constraint intact, so good rows survive recombination
+		uint64_t randomBits = 0;
+		for (size_t row = 0; row < gridSize; row++) {
+			if (row % 64 == 0) {
+				randomBits = rng();
+			}
+			if ((randomBits >> (row % 64)) & 1) {
+				swapTraitRange(result, row * gridSize, (row + 1) * gridSize, hashDelta);
+			}
+		}
+		break;
+	}
+	case CrossoverType::BoxBlock: {
+		uint64_t randomBits = 0;
+		for (size_t box = 0; box < gridSize; box++) {
+			if (box % 64 == 0) {
+				randomBits = rng();
+			}
+			if (!((randomBits >> (box % 64)) & 1)) {
+				continue;
+			}
+
+			size_t firstIndex = (box / boxSize) * boxSize * gridSize + (box % boxSize) * boxSize;
+			for (size_t row = 0; row < boxSize; row++) {
+				swapTraitRange(result, firstIndex + row * gridSize, firstIndex + row * gridSize + boxSize, hashDelta);
+			}
+		}
+		break;
+	}
+	}
 
-	std::swap_ranges(result[0].gene.begin() + slicePoint, result[0].gene.end(), result[1].gene.begin() + slicePoint);
+	if (hashDelta != 0) {
+		for (auto& child : result) {
+			child.hash ^= hashDelta;
+			child.isFitnessValid = false;
+		}
+	}
 
 	OUTPUT_VALIDITY(!result[0].gene.empty());
 	OUTPUT_VALIDITY(!result[1].gene.empty());
@@ -358,12 +1214,100 @@ std::array<Individual, 2> Scene_Algorithm::recombineIndividuals(const Individual
 	return result;
 }
 
-void Scene_Algorithm::shufflePopulation(Population_t& population) {
+void Scene_Algorithm::uniformCrossover(std::array<Individual, 2>& individuals, Rng_t& rng, uint64_t& hashDelta) noexcept {
+	INPUT_VALIDITY(individuals[0].gene.size() == individuals[1].gene.size());
+
+	Gene_t& gene1 = individuals[0].gene;
+	Gene_t& gene2 = individuals[1].gene;
+	size_t wordAmount = gene1.size() / sizeof(uint64_t);
+
+	// Blend 8 traits per word: each random byte expands to a byte mask and the masked difference is XORed into both genes
+	uint64_t randomBits = 0;
+	for (size_t word = 0; word < wordAmount; word++) {
+		if (word % 8 == 0) {
+			randomBits = rng();
+		}
+		uint64_t byteMask = BYTE_MASKS[(randomBits >> (word % 8 * 8)) & 0xFF];
+
+		uint64_t traits1, traits2;
+		std::memcpy(&traits1, gene1.data() + word * sizeof(uint64_t), sizeof(uint64_t));
+		std::memcpy(&traits2, gene2.data() + word * sizeof(uint64_t), sizeof(uint64_t));
+		uint64_t swapped = (traits1 ^ traits2) & byteMask;
+		if (swapped == 0) {
+			continue;
+		}
+
+		for (size_t byte = 0; byte < sizeof(uint64_t); byte++) {
+			if ((swapped >> (byte * 8)) & 0xFF) {
+				size_t index = word * sizeof(uint64_t) + byte;
+				hashDelta ^= Individual::traitHash(index, gene1[index]) ^ Individual::traitHash(index, gene2[index]);
+			}
+		}
+
+		traits1 ^= swapped;
+		traits2 ^= swapped;
+		std::memcpy(gene1.data() + word * sizeof(uint64_t), &traits1, sizeof(uint64_t));
+		std::memcpy(gene2.data() + word * sizeof(uint64_t), &traits2, sizeof(uint64_t));
+	}
+
+	size_t tailStart = wordAmount * sizeof(uint64_t);
+	if (tailStart < gene1.size()) {
+		uint64_t tailBits = rng();
+		for (size_t i = tailStart; i < gene1.size(); i++) {
+			if ((tailBits >> (i - tailStart)) & 1) {
+				swapTraitRange(individuals, i, i + 1, hashDelta);
+			}
+		}
+	}
+}
+
+void Scene_Algorithm::swapTraitRange(std::array<Individual, 2>& individuals, size_t start, size_t end, uint64_t& hashDelta) noexcept {
+	INPUT_VALIDITY(start <= end);
+	INPUT_VALIDITY(end <= individuals[0].gene.size());
+	INPUT_VALIDITY(individuals[0].gene.size() == individuals[1].gene.size());
+
+	Gene_t& gene1 = individuals[0].gene;
+	Gene_t& gene2 = individuals[1].gene;
+	for (size_t i = start; i < end; i++) {
+		if (gene1[i] != gene2[i]) {
+			hashDelta ^= Individual::traitHash(i, gene1[i]) ^ Individual::traitHash(i, gene2[i]);
+			std::swap(gene1[i], gene2[i]);
+		}
+	}
+}
+
+void Scene_Algorithm::shufflePopulation(Population_t& population, uint64_t seed, int64_t generation) {
+	INPUT_VALIDITY(!population.empty());
+
+	TraceScope traceScope("Shuffle");
+
+	// Fisher-Yates by hand, std::shuffle is not specified to give the same order on every standard library
+	Rng_t rng = getStreamRng(seed, RngStream::Shuffle, generation, 0);
+	for (size_t i = population.size() - 1; i > 0; i--) {
+		size_t swapIndex = static_cast<size_t>(getRandomNum(0, static_cast<int>(i), rng));
+		if (swapIndex != i) {
+			std::swap(population[i], population[swapIndex]);
+		}
+	}
+}
+
+void Scene_Algorithm::replaceDuplicates(Population_t& population, int gridSize, uint64_t seed, int64_t generation, std::pmr::memory_resource* scratch) {
 	INPUT_VALIDITY(!population.empty());
+	INPUT_VALIDITY(gridSize > 0);
+
+	TraceScope traceScope("Replace duplicates");
+
+	std::pmr::unordered_set<uint64_t> seenHashes(scratch);
+	seenHashes.reserve(population.size());
 
-	static std::random_device randDev;
-	static std::mt19937 rng(randDev());
-	std::ranges::shuffle(population, rng);
+	for (size_t i = 0; i < population.size(); i++) {
+		if (!seenHashes.insert(population[i].hash).second) {
+			Rng_t rng = getStreamRng(seed, RngStream::Duplicates, generation, i);
+			population[i] = getRandomGenesIndividual(gridSize, rng);
+		}
+	}
+
+	OUTPUT_VALIDITY(population[0].gene.size() == gridSize * gridSize);
 }
 
 
@@ -376,47 +1320,61 @@ int Scene_Algorithm::evaluationSudoku(const Individual& individual) {
 	INPUT_VALIDITY(!individual.gene.empty());
 	INPUT_VALIDITY(individual.gene.size() == gridSize * gridSize);
 	INPUT_VALIDITY(gridSize == boxSize * boxSize);
+	INPUT_VALIDITY(gridSize <= MAX_GRID_SIZE);
+
+	// One row-major pass: every row, column and box keeps the traits seen once and seen more than once.
+	// The sets are sized for the largest grid and kept per thread, so scoring an individual allocates nothing
+	// and clears only the sets its grid size uses
+	thread_local std::array<TraitSet_t, MAX_GRID_SIZE> colOnce;
+	thread_local std::array<TraitSet_t, MAX_GRID_SIZE> colTwice;
+	thread_local std::array<TraitSet_t, MAX_BOX_SIZE> boxOnce;
+	thread_local std::array<TraitSet_t, MAX_BOX_SIZE> boxTwice;
+	std::fill_n(colOnce.begin(), gridSize, TraitSet_t());
+	std::fill_n(colTwice.begin(), gridSize, TraitSet_t());
+	std::fill_n(boxOnce.begin(), boxSize, TraitSet_t());
+	std::fill_n(boxTwice.begin(), boxSize, TraitSet_t());
 
-	std::vector<int> rowTraits(gridSize);
-	std::vector<int> colTraits(gridSize);
-	std::vector<int> boxTraits(gridSize);
-
-	for (int i = 0; i < gridSize; i++) {
-		std::ranges::fill(rowTraits, 0);
-		std::ranges::fill(colTraits, 0);
+	for (int row = 0; row < gridSize; row++) {
+		TraitSet_t rowOnce;
+		TraitSet_t rowTwice;
 
-		for (int j = 0; j < gridSize; j++) {
-			rowTraits[individual.gene[i * gridSize + j]]++;
-			colTraits[individual.gene[j * gridSize + i]]++;
+		for (int col = 0; col < gridSize; col++) {
+			Trait_t trait = individual.gene[static_cast<size_t>(row) * gridSize + col];
+			markTrait(rowOnce, rowTwice, trait);
+			markTrait(colOnce[col], colTwice[col], trait);
+			markTrait(boxOnce[col / boxSize], boxTwice[col / boxSize], trait);
 		}
+		fitness += countUniqueTraits(rowOnce, rowTwice);
 
-		for (const auto& trait : rowTraits) {
-			fitness += trait == 1;
-		}
-		for (const auto& trait : colTraits) {
-			fitness += trait == 1;
+		if ((row + 1) % boxSize == 0) {
+			for (int box = 0; box < boxSize; box++) {
+				fitness += countUniqueTraits(boxOnce[box], boxTwice[box]);
+				boxOnce[box].reset();
+				boxTwice[box].reset();
+			}
 		}
 	}
 
-	for (int boxRow = 0; boxRow < boxSize; boxRow++) {
-		for (int boxCol = 0; boxCol < boxSize; boxCol++) {
-			std::ranges::fill(boxTraits, 0);
+	for (int col = 0; col < gridSize; col++) {
+		fitness += countUniqueTraits(colOnce[col], colTwice[col]);
+	}
 
-			int boxPos = boxRow * boxSize * gridSize + boxCol * boxSize;
+	return fitness;
+}
 
-			for (int row = 0; row < boxSize; row++) {
-				for (int col = 0; col < boxSize; col++) {
-					boxTraits[individual.gene[boxPos + row * gridSize + col]]++;
-				}
-			}
+void Scene_Algorithm::markTrait(TraitSet_t& seenOnce, TraitSet_t& seenTwice, Trait_t trait) noexcept {
+	INPUT_VALIDITY(trait < MAX_GRID_SIZE);
 
-			for (const auto& trait : boxTraits) {
-				fitness += trait == 1;
-			}
-		}
+	if (seenOnce.test(trait)) {
+		seenTwice.set(trait);
 	}
+	else {
+		seenOnce.set(trait);
+	}
+}
 
-	return fitness;
+int Scene_Algorithm::countUniqueTraits(const TraitSet_t& seenOnce, const TraitSet_t& seenTwice) noexcept {
+	return static_cast<int>((seenOnce & ~seenTwice).count());
 }
 
 int Scene_Algorithm::evaluationCheckers(const Individual& individual) {
@@ -489,7 +1447,6 @@ int Scene_Algorithm::evaluationDistToCenter(const Individual& individual) {
 
 
 Gene_t Scene_Algorithm::colorSudoku(const Individual& individual) {
-	Gene_t colorGene(individual.gene.size(), 0);
 	int gridSize = static_cast<int>(std::sqrt(individual.gene.size()));
 	int boxSize = static_cast<int>(std::sqrt(gridSize));
 
@@ -497,47 +1454,27 @@ Gene_t Scene_Algorithm::colorSudoku(const Individual& individual) {
 	INPUT_VALIDITY(individual.gene.size() == gridSize * gridSize);
 	INPUT_VALIDITY(gridSize == boxSize * boxSize);
 
-	std::vector<int> rowTraits(gridSize);
-	std::vector<int> colTraits(gridSize);
-	std::vector<int> boxTraits(gridSize);
-
-	for (size_t i = 0; i < gridSize; i++) {
-		std::ranges::fill(rowTraits, 0);
-		std::ranges::fill(colTraits, 0);
-
-		for (size_t j = 0; j < gridSize; j++) {
-			rowTraits[individual.gene[i * gridSize + j]]++;
-			colTraits[individual.gene[j * gridSize + i]]++;
-		}
-
-		for (size_t j = 0; j < gridSize; j++) {
-			colorGene[i * gridSize + j] += rowTraits[individual.gene[i * gridSize + j]];
-			colorGene[j * gridSize + i] += colTraits[individual.gene[j * gridSize + i]];
-		}
-	}
-
-	for (size_t boxRow = 0; boxRow < boxSize; boxRow++) {
-		for (size_t boxCol = 0; boxCol < boxSize; boxCol++) {
-			std::ranges::fill(boxTraits, 0);
-
-			size_t boxPos = boxRow * boxSize * gridSize + boxCol * boxSize;
+	// Trait counts per row, column and box, indexed [line * gridSize + trait], gathered in one row-major pass
+	std::vector<int> rowTraits(static_cast<size_t>(gridSize) * gridSize);
+	std::vector<int> colTraits(static_cast<size_t>(gridSize) * gridSize);
+	std::vector<int> boxTraits(static_cast<size_t>(gridSize) * gridSize);
 
-			for (size_t row = 0; row < boxSize; row++) {
-				for (size_t col = 0; col < boxSize; col++) {
-					boxTraits[individual.gene[boxPos + row * gridSize + col]]++;
-				}
-			}
+	auto getBox = [gridSize, boxSize](size_t cell) -> size_t {
+		return (cell / gridSize / boxSize) * boxSize + (cell % gridSize) / boxSize;
+	};
 
-			for (size_t row = 0; row < boxSize; row++) {
-				for (size_t col = 0; col < boxSize; col++) {
-					colorGene[boxPos + row * gridSize + col] += boxTraits[individual.gene[boxPos + row * gridSize + col]];
-				}
-			}
-		}
+	for (size_t cell = 0; cell < individual.gene.size(); cell++) {
+		Trait_t trait = individual.gene[cell];
+		rowTraits[(cell / gridSize) * gridSize + trait]++;
+		colTraits[(cell % gridSize) * gridSize + trait]++;
+		boxTraits[getBox(cell) * gridSize + trait]++;
 	}
 
-	for (auto& colorTrait : colorGene) {
-		colorTrait = std::min(colorTrait - 3, gridSize);
+	Gene_t colorGene(individual.gene.size());
+	for (size_t cell = 0; cell < individual.gene.size(); cell++) {
+		Trait_t trait = individual.gene[cell];
+		int repeats = rowTraits[(cell / gridSize) * gridSize + trait] + colTraits[(cell % gridSize) * gridSize + trait] + boxTraits[getBox(cell) * gridSize + trait];
+		colorGene[cell] = static_cast<Trait_t>(std::min(repeats - 3, gridSize));
 	}
 
 	OUTPUT_VALIDITY(colorGene.size() == individual.gene.size());
@@ -553,10 +1490,31 @@ Gene_t Scene_Algorithm::colorMax(const Individual& individual) {
 
 
 
+int Scene_Algorithm::optimalSudoku(int gridSize) noexcept {
+	INPUT_VALIDITY(gridSize > 0);
+
+	return 3 * gridSize * gridSize;
+}
+
+int Scene_Algorithm::optimalMax(int gridSize) noexcept {
+	INPUT_VALIDITY(gridSize > 0);
+
+	return gridSize * gridSize * (gridSize - 1);
+}
+
+int Scene_Algorithm::optimalDistToCenter(int gridSize) noexcept {
+	INPUT_VALIDITY(gridSize > 0);
+
+	return gridSize * gridSize * gridSize;
+}
+
+
+
 #pragma region GUI
 void Scene_Algorithm::gui() {
 	controls();
 	graph();
+	sweepWindow();
 	//ImGui::ShowDemoWindow();
 	//ImPlot::ShowDemoWindow();
 }
@@ -569,6 +1527,10 @@ void Scene_Algorithm::controls() {
 	ImGui::SetNextWindowSize(controlsSize);
 
 	if (ImGui::Begin("Controls window", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_AlwaysAutoResize)) {
+		if (m_sessionTabsFunc) {
+			m_sessionTabsFunc();
+		}
+
 		ImGui::Columns(2, nullptr, false);
 		ImGui::SetColumnWidth(0, controlsSize.x / 2.F);
 
@@ -577,79 +1539,85 @@ void Scene_Algorithm::controls() {
 		sliderMutationRate();
 		sliderRandomGenesRate();
 		sliderEliteSurvivalRate();
+		sliderBatchTimeBudget();
 
 		ImGui::NextColumn();
 
 		comboWindowSize();
 		comboFitnessFunc();
+		comboCrossover();
+		checkboxReplaceDuplicates();
+		checkboxSteadyState();
+		sliderSteadyStateChildren();
 		buttonPause();
+		buttonsCheckpoint();
+		buttonSweep();
+		buttonTrace();
+		textRunStats();
 	}
 	ImGui::End();
 }
 
+void Scene_Algorithm::syncControlValues() {
+	m_controlValues.boxSize           = static_cast<int>(std::sqrt(m_gridSize));
+	m_controlValues.populationSize    = m_populationSize;
+	m_controlValues.mutationRate      = m_parameters.mutationRate;
+	m_controlValues.randomGenesRate   = m_parameters.randomGenesRate;
+	m_controlValues.eliteSurvivalRate = m_parameters.eliteSurvivalRate;
+	m_controlValues.batchTimeBudgetMs = m_batchTimeBudgetMs;
+	m_controlValues.fitnessFuncIndex  = m_curFitnessFuncIndex;
+	m_controlValues.steadyStateChildAmount = m_parameters.steadyStateChildAmount;
+}
+
 void Scene_Algorithm::sliderGridSize() {
-	static int boxSize = static_cast<int>(std::sqrt(m_gridSize));
-	ImGui::SliderInt("Grid size", &boxSize, 1, 6, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Grid size", &m_controlValues.boxSize, 1, MAX_BOX_SIZE, nullptr, ImGuiSliderFlags_AlwaysClamp);
 	if (ImGui::IsItemDeactivatedAfterEdit()) {
-		m_gridSize = boxSize * boxSize;
-		m_gridPhysicalSize = computeGridPhysicalSize(m_game->getWindow().getSize(), m_relativeGridSize);
-		float cellSize = m_gridPhysicalSize / m_gridSize;
-		float relativeDif = cellSize / m_cell.getComponent<CShape>().shape.getSize().x;
-		resizeCell(relativeDif);
+		m_gridSize = m_controlValues.boxSize * m_controlValues.boxSize;
+		resizeGrid();
 
 		reset();
-
-		if (m_isPopulationUpdating) {
-			m_shouldDiscardFuturePopulation = true;
-		}
 	}
 }
 
 void Scene_Algorithm::sliderPopulationSize() {
-	static int tempPopulationSize = m_populationSize;
-	ImGui::SliderInt("Population size", &tempPopulationSize, 1, 1000, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Population size", &m_controlValues.populationSize, 1, 1000, nullptr, ImGuiSliderFlags_AlwaysClamp);
 	if (ImGui::IsItemDeactivatedAfterEdit()) {
-		int prevSize = m_populationSize;
-		m_populationSize = tempPopulationSize;
-		m_population.resize(m_populationSize);
-
-		for (int i = prevSize; i < m_populationSize; i++) {
-			m_population[i] = getRandomGenesIndividual(m_gridSize);
-		}
-
-		if (m_isPopulationUpdating) {
-			m_shouldDiscardFuturePopulation = true;
-		}
+		m_populationSize = m_controlValues.populationSize;
 	}
 }
 
 void Scene_Algorithm::sliderMutationRate() {
-	static int sliderMutationRate = m_mutationRate;
-	ImGui::SliderInt("Mutation rate", &sliderMutationRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Mutation rate", &m_controlValues.mutationRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
 	if (ImGui::IsItemDeactivatedAfterEdit()) {
-		m_mutationRate = sliderMutationRate;
+		m_parameters.mutationRate = m_controlValues.mutationRate;
 	}
 }
 
 void Scene_Algorithm::sliderRandomGenesRate() {
-	static int sliderRandomGenesRate = m_randomGenesRate;
-	ImGui::SliderInt("Random genomes rate", &sliderRandomGenesRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Random genomes rate", &m_controlValues.randomGenesRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
 	if (ImGui::IsItemDeactivatedAfterEdit()) {
-		m_randomGenesRate = sliderRandomGenesRate;
+		m_parameters.randomGenesRate = m_controlValues.randomGenesRate;
 	}
 }
 
 void Scene_Algorithm::sliderEliteSurvivalRate() {
-	static int sliderEliteSurvivalRate = m_eliteSurvivalRate;
-	ImGui::SliderInt("Elite survival rate", &sliderEliteSurvivalRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Elite survival rate", &m_controlValues.eliteSurvivalRate, 0, 100, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	if (ImGui::IsItemDeactivatedAfterEdit()) {
+		m_parameters.eliteSurvivalRate = m_controlValues.eliteSurvivalRate;
+	}
+}
+
+void Scene_Algorithm::sliderBatchTimeBudget() {
+	ImGui::SliderInt("Batch time (ms, 0 = frame)", &m_controlValues.batchTimeBudgetMs, 0, 1000, nullptr, ImGuiSliderFlags_AlwaysClamp);
 	if (ImGui::IsItemDeactivatedAfterEdit()) {
-		m_eliteSurvivalRate = sliderEliteSurvivalRate;
+		m_batchTimeBudgetMs = m_controlValues.batchTimeBudgetMs;
 	}
 }
 
 void Scene_Algorithm::comboWindowSize() {
 	static const std::vector<const char*> comboItems = { "Full screen", "3840x2160", "2560x1440" , "1920x1080" , "1600x900", "1280x720" , "1024x576" };
 	static const std::vector<int> windowSizes = { 1, 240, 160, 120, 100, 80, 64 };
+	// Static, since every session shows the mode of the one shared window
 	static int currentItemIndex = 6;
 	static int prevItemIndex = currentItemIndex;
 	static int itemAmount = static_cast<int>(comboItems.size());
@@ -670,13 +1638,22 @@ void Scene_Algorithm::comboWindowSize() {
 				m_game->getWindow().setSize(sf::Vector2u(16 * windowSizes[currentItemIndex], 9 * windowSizes[currentItemIndex]));
 			}
 		}
-		float prevGridPhysicalSize = m_gridPhysicalSize;
-		m_gridPhysicalSize = computeGridPhysicalSize(m_game->getWindow().getSize(), m_relativeGridSize);
-		resizeCell(m_gridPhysicalSize / prevGridPhysicalSize);
+		// Recreating the window for full screen sends no resize event, so the other sessions are resized here as well
+		if (m_windowChangedFunc) {
+			m_windowChangedFunc();
+		}
+		else {
+			resizeGrid();
+		}
 		prevItemIndex = currentItemIndex;
 	}
 }
 
+void Scene_Algorithm::resizeGrid() {
+	m_gridPhysicalSize = computeGridPhysicalSize(m_game->getWindow().getSize(), m_relativeGridSize);
+	m_gridRenderer.resize(m_gridSize, m_gridPhysicalSize);
+}
+
 int Scene_Algorithm::getOptimalScreenSizeIndex(sf::Vector2i maxSceenSize, const std::vector<int>& screenSizes, int selectedIndex) noexcept {
 	INPUT_VALIDITY(maxSceenSize.x > 0 && maxSceenSize.y > 0);
 	INPUT_VALIDITY(!screenSizes.empty());
@@ -698,20 +1675,244 @@ int Scene_Algorithm::getOptimalScreenSizeIndex(sf::Vector2i maxSceenSize, const
 }
 
 void Scene_Algorithm::comboFitnessFunc() {
-	static const std::vector<const char*> comboItems = { "Sudoku", "Checkers", "Max", "Min", "DistToCenter" };
+	if (ImGui::BeginCombo("Fitness function", m_fitnessFuncNames[m_controlValues.fitnessFuncIndex].c_str())) {
+		for (int i = 0; i < static_cast<int>(m_fitnessFuncNames.size()); i++) {
+			if (ImGui::Selectable(m_fitnessFuncNames[i].c_str(), i == m_controlValues.fitnessFuncIndex) && i != m_controlValues.fitnessFuncIndex) {
+				m_controlValues.fitnessFuncIndex = i;
+				m_curFitnessFuncIndex = i;
+				reset();
+			}
+		}
+		ImGui::EndCombo();
+	}
+}
 
-	static int currentItemIndex = m_curFitnessFuncIndex;
-	static int itemAmount = static_cast<int>(comboItems.size());
+void Scene_Algorithm::checkboxReplaceDuplicates() {
+	bool shouldReplaceDuplicates = m_parameters.shouldReplaceDuplicates;
+	if (ImGui::Checkbox("Replace duplicates", &shouldReplaceDuplicates)) {
+		m_parameters.shouldReplaceDuplicates = shouldReplaceDuplicates;
+	}
+}
 
-	if (ImGui::Combo("Fitness function", &currentItemIndex, comboItems.data(), itemAmount, itemAmount)) {
-		m_curFitnessFuncIndex = currentItemIndex;
-		reset();
+void Scene_Algorithm::checkboxSteadyState() {
+	bool isSteadyState = m_parameters.isSteadyState;
+	if (ImGui::Checkbox("Steady state", &isSteadyState)) {
+		m_parameters.isSteadyState = isSteadyState;
+	}
+}
+
+void Scene_Algorithm::sliderSteadyStateChildren() {
+	if (!m_parameters.isSteadyState) {
+		return;
+	}
+
+	ImGui::SliderInt("Children per step", &m_controlValues.steadyStateChildAmount, 1, std::max(1, m_populationSize - 1), nullptr, ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
+	if (ImGui::IsItemDeactivatedAfterEdit()) {
+		m_parameters.steadyStateChildAmount = m_controlValues.steadyStateChildAmount;
+	}
+}
+
+void Scene_Algorithm::comboCrossover() {
+	int crossoverType = static_cast<int>(m_parameters.crossoverType.load());
+	if (ImGui::Combo("Crossover", &crossoverType, CROSSOVER_NAMES.data(), CROSSOVER_TYPE_AMOUNT)) {
+		m_parameters.crossoverType = static_cast<CrossoverType>(crossoverType);
 	}
 }
 
 void Scene_Algorithm::buttonPause() {
 	if (ImGui::Button("Pause genetic algorithm")) {
 		m_isPaused = !m_isPaused;
+		m_runTimer.pause();
+	}
+}
+
+void Scene_Algorithm::buttonsCheckpoint() {
+	if (ImGui::Button("Save checkpoint")) {
+		m_isCheckpointRequested = true;
+		if (!m_isPopulationUpdating) {
+			saveCheckpoint();
+		}
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Load checkpoint")) {
+		loadCheckpoint();
+	}
+}
+
+void Scene_Algorithm::textRunStats() {
+	if (m_isSolved) {
+		ImGui::Text("Solved at generation %lld in %d ms", static_cast<long long>(m_solveGeneration), m_solveTimeMs);
+	}
+	else {
+		ImGui::Text("Generation %lld, %d ms", static_cast<long long>(m_curGeneration), m_runTimer.timeElapsed());
+	}
+	ImGui::Text("%d generations per update", m_generationsPerUpdate);
+	ImGui::Text("Seed %llu, trace checksum %016llx", static_cast<unsigned long long>(m_seed), static_cast<unsigned long long>(m_traceChecksum));
+}
+
+void Scene_Algorithm::buttonSweep() {
+	if (ImGui::Button("Parameter sweep")) {
+		m_isSweepWindowOpen = !m_isSweepWindowOpen;
+	}
+}
+
+void Scene_Algorithm::buttonTrace() {
+	if (!Tracer::isEnabled()) {
+		if (ImGui::Button("Start trace")) {
+			Tracer::start();
+		}
+		return;
+	}
+
+	if (ImGui::Button("Stop and save trace")) {
+		Tracer::stop();
+		if (Tracer::writeJson(m_tracePath)) {
+			std::cout << "Scene_Algorithm: trace written to \"" << m_tracePath << "\"\n";
+		}
+	}
+}
+
+void Scene_Algorithm::sweepWindow() {
+	if (!m_isSweepWindowOpen) {
+		return;
+	}
+
+	ImGui::SetNextWindowSize(ImVec2(720, 480), ImGuiCond_FirstUseEver);
+	if (ImGui::Begin("Parameter sweep", &m_isSweepWindowOpen)) {
+		sweepSettingsControls();
+		ImGui::Separator();
+		sweepResultsTable();
+	}
+	ImGui::End();
+}
+
+void Scene_Algorithm::sweepSettingsControls() {
+	static const std::vector<const char*> samplingItems = { "Grid", "Random", "Latin hypercube" };
+	static int samplingItemAmount = static_cast<int>(samplingItems.size());
+
+	bool isRunning = m_sweep.isRunning();
+	ImGui::BeginDisabled(isRunning);
+
+	int samplingIndex = static_cast<int>(m_sweepSettings.sampling);
+	if (ImGui::Combo("Sampling", &samplingIndex, samplingItems.data(), samplingItemAmount, samplingItemAmount)) {
+		m_sweepSettings.sampling = static_cast<SweepSampling>(samplingIndex);
+	}
+	bool isGrid = m_sweepSettings.sampling == SweepSampling::Grid;
+
+	sweepRangeInput("Population size", m_sweepSettings.populationSize, 1, 1000, isGrid);
+	sweepRangeInput("Mutation rate", m_sweepSettings.mutationRate, 0, 100, isGrid);
+	sweepRangeInput("Random genomes rate", m_sweepSettings.randomGenesRate, 0, 100, isGrid);
+	sweepRangeInput("Elite survival rate", m_sweepSettings.eliteSurvivalRate, 0, 100, isGrid);
+	ImGui::TextUnformatted("Crossover");
+	for (int i = 0; i < CROSSOVER_TYPE_AMOUNT; i++) {
+		ImGui::SameLine();
+		ImGui::Checkbox(CROSSOVER_NAMES[i], &m_sweepSettings.crossoverTypes[i]);
+	}
+	if (!isGrid) {
+		ImGui::SliderInt("Samples", &m_sweepSettings.sampleAmount, 1, 1000, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	}
+	ImGui::SliderInt("Seeds per configuration", &m_sweepSettings.seedAmount, 1, 32, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::SliderInt("Max generations", &m_sweepSettings.maxGenerations, 1, 100'000, nullptr, ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
+	ImGui::SliderInt("Time limit (ms)", &m_sweepSettings.timeLimitMs, 1, 600'000, nullptr, ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
+	ImGui::SliderInt("Threads (0 = all cores)", &m_sweepSettings.threadAmount, 0, 256, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	ImGui::InputScalar("Sweep seed", ImGuiDataType_U64, &m_sweepSettings.seed);
+
+	if (ImGui::Button("Start sweep")) {
+		startSweep();
+	}
+	ImGui::EndDisabled();
+
+	ImGui::SameLine();
+	ImGui::BeginDisabled(!isRunning);
+	if (ImGui::Button("Cancel sweep")) {
+		m_sweep.cancel();
+	}
+	ImGui::EndDisabled();
+
+	size_t jobAmount = std::max<size_t>(1, m_sweep.getJobAmount());
+	std::string progressText = std::to_string(m_sweep.getDoneAmount()) + " / " + std::to_string(m_sweep.getJobAmount()) + " runs";
+	ImGui::SameLine();
+	ImGui::ProgressBar(static_cast<float>(m_sweep.getDoneAmount()) / jobAmount, ImVec2(-1, 0), progressText.c_str());
+}
+
+void Scene_Algorithm::sweepRangeInput(const char* label, SweepRange& range, int minValue, int maxValue, bool hasSteps) {
+	INPUT_VALIDITY(minValue <= maxValue);
+
+	ImGui::PushID(label);
+	ImGui::DragIntRange2(label, &range.min, &range.max, 1.f, minValue, maxValue, "Min: %d", "Max: %d", ImGuiSliderFlags_AlwaysClamp);
+	if (hasSteps) {
+		ImGui::SliderInt("Steps", &range.steps, 1, 16, nullptr, ImGuiSliderFlags_AlwaysClamp);
+	}
+	ImGui::PopID();
+}
+
+void Scene_Algorithm::sweepResultsTable() {
+	static const std::vector<const char*> columnNames = { "Population", "Mutation", "Random genomes", "Elite", "Crossover", "Solved", "Best fitness", "Time to best (ms)", "Generations/s", "Expected time (ms)" };
+	static const int columnAmount = static_cast<int>(columnNames.size());
+
+	std::vector<SweepSummary>& summaries = m_sweep.getSummaries();
+	ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+
+	if (ImGui::BeginTable("Sweep results", columnAmount, flags)) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		for (int i = 0; i < columnAmount; i++) {
+			ImGuiTableColumnFlags columnFlags = i == columnAmount - 1 ? ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortAscending : ImGuiTableColumnFlags_PreferSortDescending;
+			ImGui::TableSetupColumn(columnNames[i], columnFlags);
+		}
+		ImGui::TableHeadersRow();
+
+		ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+		if (sortSpecs != nullptr && (sortSpecs->SpecsDirty || m_shouldSortSweepTable)) {
+			std::ranges::stable_sort(summaries, [sortSpecs](const SweepSummary& summary1, const SweepSummary& summary2) {
+				for (int i = 0; i < sortSpecs->SpecsCount; i++) {
+					const ImGuiTableColumnSortSpecs& columnSpecs = sortSpecs->Specs[i];
+					double value1 = getSweepColumnValue(summary1, columnSpecs.ColumnIndex);
+					double value2 = getSweepColumnValue(summary2, columnSpecs.ColumnIndex);
+					if (value1 != value2) {
+						return columnSpecs.SortDirection == ImGuiSortDirection_Ascending ? value1 < value2 : value1 > value2;
+					}
+				}
+				return false;
+			});
+			sortSpecs->SpecsDirty = false;
+			m_shouldSortSweepTable = false;
+		}
+
+		for (const auto& summary : summaries) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("%d", summary.config.populationSize);
+			ImGui::TableNextColumn(); ImGui::Text("%d", summary.config.mutationRate);
+			ImGui::TableNextColumn(); ImGui::Text("%d", summary.config.randomGenesRate);
+			ImGui::TableNextColumn(); ImGui::Text("%d", summary.config.eliteSurvivalRate);
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(CROSSOVER_NAMES[static_cast<int>(summary.config.crossoverType)]);
+			ImGui::TableNextColumn(); ImGui::Text("%d / %d", summary.solvedAmount, summary.runAmount);
+			ImGui::TableNextColumn(); ImGui::Text("%.1f", summary.avgBestFitness);
+			ImGui::TableNextColumn(); ImGui::Text("%.1f", summary.avgTimeToBestMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.0f", summary.avgGenerationsPerSec);
+			ImGui::TableNextColumn();
+			if (summary.solvedAmount > 0) {
+				ImGui::Text("%.1f", summary.expectedRunTimeMs);
+			}
+			else {
+				ImGui::TextUnformatted("-");
+			}
+		}
+		ImGui::EndTable();
+	}
+}
+
+double Scene_Algorithm::getSweepColumnValue(const SweepSummary& summary, int column) noexcept {
+	switch (column) {
+	case 0: return summary.config.populationSize;
+	case 1: return summary.config.mutationRate;
+	case 2: return summary.config.randomGenesRate;
+	case 3: return summary.config.eliteSurvivalRate;
+	case 4: return static_cast<double>(summary.config.crossoverType);
+	case 5: return static_cast<double>(summary.solvedAmount) / std::max(1, summary.runAmount);
+	case 6: return summary.avgBestFitness;
+	case 7: return summary.avgTimeToBestMs;
+	case 8: return summary.avgGenerationsPerSec;
+	default: return summary.expectedRunTimeMs;
 	}
 }
 
@@ -728,9 +1929,12 @@ void Scene_Algorithm::graph() {
 
 	if (ImGui::Begin("Graph window", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_AlwaysAutoResize)) {
 		if (ImPlot::BeginPlot("Plots", ImGui::GetContentRegionAvail(), ImPlotFlags_NoTitle | ImPlotFlags_NoMenus)) {
-			ImPlot::PlotLine("Max fitness", m_maxFitnessValues.data(), m_curUpdate, m_generationsPerUpdate);
-			ImPlot::PlotLine("Min fitness", m_minFitnessValues.data(), m_curUpdate, m_generationsPerUpdate);
-			ImPlot::PlotLine("Avg fitness", m_avgFitnessValues.data(), m_curUpdate, m_generationsPerUpdate);
+			const FitnessPlotData& plotData = m_fitnessHistory.getPlotData();
+			int pointAmount = static_cast<int>(plotData.generations.size());
+
+			ImPlot::PlotLine("Max fitness", plotData.generations.data(), plotData.maxValues.data(), pointAmount);
+			ImPlot::PlotLine("Min fitness", plotData.generations.data(), plotData.minValues.data(), pointAmount);
+			ImPlot::PlotLine("Avg fitness", plotData.generations.data(), plotData.avgValues.data(), pointAmount);
 		}
 		ImPlot::EndPlot();
 	}
@@ -742,19 +1946,39 @@ void Scene_Algorithm::graph() {
 
 
 void Scene_Algorithm::update() {
-	if (!m_isPaused) {
-		if (!m_isPopulationUpdating && m_curUpdate < m_updateLimit) {
-			m_isPopulationUpdating = true;
-			m_futurePopulation = std::async(std::launch::async, &Scene_Algorithm::updatePopulation, m_population, m_gridSize, m_mutationRate, m_randomGenesRate, m_eliteSurvivalRate, 
-											m_generationsPerUpdate, m_game->getFramerateLimit(), std::ref(m_fitnessFunctions[m_curFitnessFuncIndex]));
-		}
+	TraceScope traceScope("Scene update");
+
+	if (m_sweep.update()) {
+		m_sweep.writeCsv(m_sweepCsvPath);
+		m_shouldSortSweepTable = true;
+	}
 
+	if (!m_isPaused) {
 		if (m_futurePopulation.valid() && m_futurePopulation.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
 			if (!m_shouldDiscardFuturePopulation) {
-				m_population = m_futurePopulation.get();
-				sortMostFitInividual(m_population);
-				m_colorGene = m_colorFunctions[m_curFitnessFuncIndex](m_population[0]);
-				addGenerationToGraph();
+				receiveSnapshot();
+
+				PopulationBatch batch = m_futurePopulation.get();
+				m_population = std::move(batch.population);
+				m_colorGene = std::move(batch.colorGene);
+				m_traceChecksum = batch.traceChecksum;
+				m_bestHash = batch.bestHash;
+
+				m_curGeneration += batch.generationsDone;
+
+				int64_t elapsedUs = std::max<int64_t>(1, batch.elapsedUs);
+				int64_t wallUs = std::max<int64_t>(elapsedUs, m_runTimer.timeElapsedUs() - m_batchStartTimeUs);
+				uint64_t evaluations = m_metrics.evaluations.load(std::memory_order_relaxed) - m_batchStartEvaluations;
+				m_metrics.generationsPerSec.store(batch.generationsDone * 1'000'000.0 / elapsedUs, std::memory_order_relaxed);
+				m_metrics.evaluationsPerSec.store(evaluations * 1'000'000.0 / elapsedUs, std::memory_order_relaxed);
+				m_metrics.batchThreadUtilization.store(static_cast<double>(elapsedUs) / wallUs, std::memory_order_relaxed);
+
+				if (batch.isSolved) {
+					recordSolution(m_curGeneration, m_batchStartTimeMs + batch.solveTimeMs);
+				}
+				else {
+					adaptGenerationsPerUpdate(batch.generationsDone, batch.elapsedUs);
+				}
 			}
 			else {
 				m_futurePopulation.get();
@@ -762,7 +1986,23 @@ void Scene_Algorithm::update() {
 			m_isPopulationUpdating = false;
 			m_shouldDiscardFuturePopulation = false;
 		}
+		else {
+			receiveSnapshot();
+		}
+
+		if (m_checkpointIntervalSec > 0 && m_checkpointTimer.timeElapsed() >= m_checkpointIntervalSec * 1'000) {
+			m_isCheckpointRequested = true;
+		}
+		// The population is only in hand between batches, so that is where it gets captured
+		if (m_isCheckpointRequested && !m_isPopulationUpdating) {
+			saveCheckpoint();
+		}
+
+		if (!m_isPopulationUpdating && !m_isSolved) {
+			launchPopulationUpdate();
+		}
 	}
+	updateMetrics();
 	m_currentFrame++;
 }
 
@@ -773,11 +2013,13 @@ void Scene_Algorithm::sDoAction(const Action& action) {
 		case ActionType::Quit:
 			m_game->quit();
 			break;
+		case ActionType::Resized:
+			resizeGrid();
+			break;
 		//case ActionType::LeftClick: break;
 		//case ActionType::RightClick: break;
 		//case ActionType::MiddleClick: break;
 		//case ActionType::MouseMove: break;
-		//case ActionType::Resized: break;
 		}
 	//case ActionStage::End:
 		//switch (action.getType()) {
@@ -789,51 +2031,13 @@ void Scene_Algorithm::sDoAction(const Action& action) {
 }
 
 void Scene_Algorithm::sRender() {
-	drawCells();
-	drawBoxLines();
+	TraceScope traceScope("Scene render");
+
+	drawGrid();
 	gui();
 }
 
-void Scene_Algorithm::drawCells() {
-	auto& cellSh = m_cell.getComponent<CShape>().shape;
-	auto& cellText = m_cell.getComponent<CText>().text;
-
-	sf::Vector2f cellPos = m_cell.getComponent<CTransform>().pos;
-	sf::Vector2f cellSize = cellSh.getSize();
-	float colorShare = 255 / (m_gridSize * m_colorWeights[m_curFitnessFuncIndex]);
-
-	auto& mostFitIndividual = m_population[0];
-
-	for (int i = 0; i < mostFitIndividual.gene.size(); i++) {
-		int row = i / m_gridSize;
-		int col = i % m_gridSize;
-
-		sf::Vector2f newPos = cellPos + sf::Vector2f(col * cellSize.x, row * cellSize.y);
-		int gbColor = 255 - std::min(static_cast<int>(std::round(colorShare * m_colorGene[i])), 255);
-		cellSh.setPosition(newPos);
-		cellSh.setFillColor(sf::Color(255, gbColor, gbColor));
-
-		cellText.setString(std::to_string(mostFitIndividual.gene[i] + 1));
-		cellText.setPosition(newPos);
-		MyUtils::centerText(cellText);
-
-		m_game->getWindow().draw(cellSh);
-		m_game->getWindow().draw(cellText);
-	}
+void Scene_Algorithm::drawGrid() {
+	m_gridRenderer.update(m_shownSnapshot.bestGene, m_shownSnapshot.colorGene, getColorShare());
+	m_gridRenderer.draw(m_game->getWindow());
 }
-
-void Scene_Algorithm::drawBoxLines() {
-	float cellSize = m_cell.getComponent<CShape>().shape.getSize().x;
-	int boxSize = static_cast<int>(std::sqrt(m_gridSize));
-	sf::VertexArray lines(sf::Lines, (boxSize - 1) * 2 * 2);
-
-	size_t curIndex = 0;
-	for (int i = 1; i < boxSize; i++) {
-		lines[curIndex++] = sf::Vertex(sf::Vector2f(cellSize * boxSize * i, 0), sf::Color::Black);
-		lines[curIndex++] = sf::Vertex(sf::Vector2f(cellSize * boxSize * i, m_gridPhysicalSize), sf::Color::Black);
-
-		lines[curIndex++] = sf::Vertex(sf::Vector2f(0, cellSize * boxSize * i), sf::Color::Black);
-		lines[curIndex++] = sf::Vertex(sf::Vector2f(m_gridPhysicalSize, i * cellSize * boxSize ), sf::Color::Black);
-	}
-	m_game->getWindow().draw(lines);
-}
\ No newline at end of file
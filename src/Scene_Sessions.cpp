@@ -0,0 +1,213 @@
+#include "Scene_Sessions.h"
+#include "GameEngine.h"
+#include "WorkerPool.h"
+
+
+Scene_Sessions::Scene_Sessions(GameEngine* gameEngine)
+	: Scene{ gameEngine } {
+
+	INPUT_VALIDITY(gameEngine != nullptr);
+
+	init();
+
+	OUTPUT_VALIDITY(!m_sessions.empty());
+	OUTPUT_VALIDITY(m_activeSessionIndex < m_sessions.size());
+}
+
+Scene_Sessions::~Scene_Sessions() {
+	m_metricsServer.stop();
+}
+
+void Scene_Sessions::init() {
+	registerAction(sf::Keyboard::Escape, ActionType::Quit);
+
+	loadFromConfig();
+	for (int i = 0; i < m_initialSessionAmount; i++) {
+		addSession();
+	}
+	m_activeSessionIndex = 0;
+
+	if (m_metricsEndpoint != "none") {
+		m_metricsServer.start(m_metricsEndpoint, [this]() { return renderMetrics(); });
+	}
+}
+
+void Scene_Sessions::loadFromConfig() {
+	for (const auto& line : m_game->readConfigLines()) {
+		std::stringstream iss(line);
+		std::string type;
+		iss >> type;
+
+		if (type == "Sessions") {
+			iss >> m_initialSessionAmount;
+		}
+		else if (type == "Metrics") {
+			iss >> m_metricsEndpoint;
+		}
+		else if (type == "Affinity") {
+			// An invalid list is reported by the sessions, which read the same line
+			std::string cpuList;
+			iss >> cpuList;
+			m_threadPlacement = ThreadPlacement::parse(cpuList).value_or(ThreadPlacement());
+		}
+	}
+
+	if (m_initialSessionAmount < 1 || m_initialSessionAmount > MAX_SESSION_AMOUNT) {
+		std::cerr << "Scene_Sessions::loadFromConfig: Invalid session amount " << m_initialSessionAmount << ", using 1\n";
+		m_initialSessionAmount = 1;
+	}
+	if (m_metricsEndpoint.empty()) {
+		m_metricsEndpoint = "none";
+	}
+}
+
+void Scene_Sessions::update() {
+	// Every session collects its finished batch and launches the next one, so hidden sessions keep evolving
+	for (const auto& session : m_sessions) {
+		session->update();
+	}
+}
+
+void Scene_Sessions::sDoAction(const Action& action) {
+	if (action.getType() == ActionType::Resized) {
+		resizeSessions();
+		return;
+	}
+
+	m_sessions[m_activeSessionIndex]->sDoAction(action);
+}
+
+void Scene_Sessions::sRender() {
+	m_sessions[m_activeSessionIndex]->sRender();
+	applyTabRequests();
+}
+
+void Scene_Sessions::sessionTabs() {
+	if (!ImGui::BeginTabBar("Sessions")) {
+		return;
+	}
+
+	for (size_t i = 0; i < m_sessions.size(); i++) {
+		const Scene_Algorithm& session = *m_sessions[i];
+		// The part after ### keeps the tab id stable when the fitness function of the session changes
+		std::string label = "Session " + std::to_string(session.getSessionNumber()) + ": " + session.getFitnessFuncName() + "###Session" + std::to_string(session.getSessionNumber());
+		ImGuiTabItemFlags flags = (m_shouldSelectActiveTab && i == m_activeSessionIndex) ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None;
+		bool isOpen = true;
+
+		if (ImGui::BeginTabItem(label.c_str(), m_sessions.size() > 1 ? &isOpen : nullptr, flags)) {
+			// While a selection is forced, the previously selected tab still reports itself for this frame
+			if (i != m_activeSessionIndex && !m_shouldSelectActiveTab) {
+				m_sessionIndexToSelect = i;
+			}
+			ImGui::EndTabItem();
+		}
+		if (!isOpen) {
+			m_sessionIndexToClose = i;
+		}
+	}
+
+	if (static_cast<int>(m_sessions.size()) < MAX_SESSION_AMOUNT && ImGui::TabItemButton("+", ImGuiTabItemFlags_Trailing | ImGuiTabItemFlags_NoTooltip)) {
+		m_shouldAddSession = true;
+	}
+
+	ImGui::EndTabBar();
+	m_shouldSelectActiveTab = false;
+}
+
+void Scene_Sessions::applyTabRequests() {
+	if (m_sessionIndexToClose) {
+		closeSession(*m_sessionIndexToClose);
+	}
+	else if (m_sessionIndexToSelect) {
+		m_activeSessionIndex = *m_sessionIndexToSelect;
+	}
+
+	if (m_shouldAddSession) {
+		addSession();
+		m_activeSessionIndex = m_sessions.size() - 1;
+		m_shouldSelectActiveTab = true;
+	}
+
+	m_sessionIndexToClose.reset();
+	m_sessionIndexToSelect.reset();
+	m_shouldAddSession = false;
+
+	OUTPUT_VALIDITY(m_activeSessionIndex < m_sessions.size());
+}
+
+void Scene_Sessions::addSession() {
+	INPUT_VALIDITY(static_cast<int>(m_sessions.size()) < MAX_SESSION_AMOUNT);
+
+	auto session = std::make_unique<Scene_Algorithm>(m_game, getFreeSessionNumber());
+	session->setSessionTabsFunc([this]() { sessionTabs(); });
+	session->setWindowChangedFunc([this]() { resizeSessions(); });
+
+	{
+		std::lock_guard<std::mutex> lock(m_sessionsMutex);
+		m_sessions.emplace_back(std::move(session));
+	}
+	updateGaThreadAmount();
+}
+
+void Scene_Sessions::closeSession(size_t sessionIndex) {
+	INPUT_VALIDITY(sessionIndex < m_sessions.size());
+	INPUT_VALIDITY(m_sessions.size() > 1);
+
+	std::unique_ptr<Scene_Algorithm> closedSession;
+	{
+		std::lock_guard<std::mutex> lock(m_sessionsMutex);
+		closedSession = std::move(m_sessions[sessionIndex]);
+		m_sessions.erase(m_sessions.begin() + static_cast<std::ptrdiff_t>(sessionIndex));
+	}
+
+	if (m_activeSessionIndex > sessionIndex || m_activeSessionIndex == m_sessions.size()) {
+		m_activeSessionIndex--;
+	}
+	m_shouldSelectActiveTab = true;
+	updateGaThreadAmount();
+
+	// Destroyed outside the lock, the session waits for its running batch and a scrape should not wait with it
+	closedSession.reset();
+}
+
+void Scene_Sessions::resizeSessions() {
+	// Hidden sessions are resized too, so they fit the window as soon as their tab is selected
+	for (const auto& session : m_sessions) {
+		session->sDoAction(Action(ActionType::Resized, ActionStage::Start));
+	}
+}
+
+void Scene_Sessions::updateGaThreadAmount() {
+	// Session N pins its GA thread to the N-th Affinity core, so sweeps of every session start after the highest number
+	int highestSessionNumber = 1;
+	for (const auto& session : m_sessions) {
+		highestSessionNumber = std::max(highestSessionNumber, session->getSessionNumber());
+	}
+	for (const auto& session : m_sessions) {
+		session->setGaThreadAmount(static_cast<size_t>(highestSessionNumber));
+	}
+	// The parallel views run on the cores after the GA threads too
+	WorkerPool::Instance().init(m_threadPlacement, static_cast<size_t>(highestSessionNumber));
+}
+
+int Scene_Sessions::getFreeSessionNumber() const {
+	// The lowest free number, so a reopened session reuses the files and the core of a closed one
+	int sessionNumber = 1;
+	while (std::ranges::any_of(m_sessions, [sessionNumber](const auto& session) { return session->getSessionNumber() == sessionNumber; })) {
+		sessionNumber++;
+	}
+
+	return sessionNumber;
+}
+
+std::string Scene_Sessions::renderMetrics() const {
+	std::vector<std::pair<int, const GaMetrics*>> sessionMetrics;
+
+	std::lock_guard<std::mutex> lock(m_sessionsMutex);
+	sessionMetrics.reserve(m_sessions.size());
+	for (const auto& session : m_sessions) {
+		sessionMetrics.emplace_back(session->getSessionNumber(), &session->getMetrics());
+	}
+
+	return GaMetrics::toPrometheusText(sessionMetrics);
+}
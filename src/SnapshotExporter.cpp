@@ -0,0 +1,73 @@
+#include "SnapshotExporter.h"
+#include <filesystem>
+
+
+SnapshotExporter::SnapshotExporter(size_t queueCapacity)
+	: m_queueCapacity(queueCapacity)
+	, m_thread([this](std::stop_token stopToken) { run(stopToken); }) {
+
+	INPUT_VALIDITY(queueCapacity > 0);
+}
+
+SnapshotExporter::~SnapshotExporter() {
+	m_thread.request_stop();
+	m_thread.join();
+}
+
+bool SnapshotExporter::push(sf::Image&& image, std::string path) {
+	INPUT_VALIDITY(!path.empty());
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_queue.size() >= m_queueCapacity) {
+			m_droppedAmount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		m_queue.push_back({ std::move(image), std::move(path) });
+	}
+	m_condition.notify_one();
+
+	return true;
+}
+
+size_t SnapshotExporter::getQueuedAmount() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_queue.size();
+}
+
+size_t SnapshotExporter::getWrittenAmount() const noexcept {
+	return m_writtenAmount.load(std::memory_order_relaxed);
+}
+
+size_t SnapshotExporter::getDroppedAmount() const noexcept {
+	return m_droppedAmount.load(std::memory_order_relaxed);
+}
+
+void SnapshotExporter::run(std::stop_token stopToken) {
+	while (true) {
+		SnapshotExportJob job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			// Returns false only once a stop was requested and the queue is drained
+			if (!m_condition.wait(lock, stopToken, [this]() { return !m_queue.empty(); })) {
+				return;
+			}
+			job = std::move(m_queue.front());
+			m_queue.pop_front();
+		}
+
+		std::filesystem::path parentPath = std::filesystem::path(job.path).parent_path();
+		std::error_code error;
+		if (!parentPath.empty()) {
+			std::filesystem::create_directories(parentPath, error);
+		}
+
+		// Encoding runs outside the lock, so push() only ever waits for a queue operation
+		if (job.image.saveToFile(job.path)) {
+			m_writtenAmount.fetch_add(1, std::memory_order_relaxed);
+		}
+		else {
+			std::cerr << "SnapshotExporter::run: Cannot write image with path \"" << job.path << "\"\n";
+		}
+	}
+}
@@ -0,0 +1,290 @@
+#include "Sweep.h"
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <cmath>
+
+
+Sweep::~Sweep() {
+	cancel();
+	for (auto& worker : m_workers) {
+		worker.wait();
+	}
+}
+
+void Sweep::start(const SweepSettings& settings, SweepJobFunc_t jobFunc) {
+	INPUT_VALIDITY(!m_isRunning);
+	INPUT_VALIDITY(jobFunc != nullptr);
+	INPUT_VALIDITY(settings.seedAmount > 0);
+	INPUT_VALIDITY(settings.threadAmount >= 0);
+
+	m_configs = sampleConfigs(settings);
+	m_seeds.resize(settings.seedAmount);
+	for (size_t i = 0; i < m_seeds.size(); i++) {
+		m_seeds[i] = MyUtils::mixHash(settings.seed + i);
+	}
+	m_results.assign(m_configs.size() * m_seeds.size(), SweepRunResult{});
+	m_summaries.clear();
+	m_jobFunc = std::move(jobFunc);
+	m_stopSource = std::stop_source();
+	m_nextJob = 0;
+	m_doneAmount = 0;
+	m_isRunning = true;
+
+	size_t freeCpuAmount = settings.placement.getCpuAmount() > settings.firstWorkerIndex ? settings.placement.getCpuAmount() - settings.firstWorkerIndex : 1;
+	size_t defaultThreadAmount = settings.placement.isEnabled() ? freeCpuAmount : std::max(1u, std::thread::hardware_concurrency());
+	size_t threadAmount = settings.threadAmount > 0 ? settings.threadAmount : defaultThreadAmount;
+	threadAmount = std::min(threadAmount, m_results.size());
+	m_workers.clear();
+	for (size_t i = 0; i < threadAmount; i++) {
+		m_workers.emplace_back(std::async(std::launch::async, &Sweep::runJobs, this, settings.firstWorkerIndex + i, settings.placement, m_stopSource.get_token()));
+	}
+
+	OUTPUT_VALIDITY(!m_configs.empty());
+	OUTPUT_VALIDITY(!m_workers.empty());
+}
+
+void Sweep::cancel() {
+	m_stopSource.request_stop();
+}
+
+bool Sweep::update() {
+	if (!m_isRunning) {
+		return false;
+	}
+
+	for (const auto& worker : m_workers) {
+		if (worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return false;
+		}
+	}
+
+	for (auto& worker : m_workers) {
+		worker.get();
+	}
+	m_workers.clear();
+	m_isRunning = false;
+	summarize();
+
+	return true;
+}
+
+bool Sweep::isRunning() const noexcept {
+	return m_isRunning;
+}
+
+size_t Sweep::getDoneAmount() const noexcept {
+	return m_doneAmount.load(std::memory_order_relaxed);
+}
+
+size_t Sweep::getJobAmount() const noexcept {
+	return m_results.size();
+}
+
+std::vector<SweepSummary>& Sweep::getSummaries() noexcept {
+	return m_summaries;
+}
+
+bool Sweep::writeCsv(const std::string& path) const {
+	INPUT_VALIDITY(!m_isRunning);
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		std::cerr << "Sweep::writeCsv: Cannot open file with path \"" << path << "\"\n";
+		return false;
+	}
+
+	file << "config,seed,population_size,mutation_rate,random_genes_rate,elite_survival_rate,crossover,"
+		<< "best_fitness,final_fitness,solved,generations,generation_of_best,time_to_best_ms,run_time_ms,generations_per_sec\n";
+	for (const auto& result : m_results) {
+		if (!result.isDone) {
+			continue;
+		}
+
+		const SweepConfig& config = m_configs[result.configIndex];
+		file << result.configIndex << ',' << result.seed << ','
+			<< config.populationSize << ',' << config.mutationRate << ',' << config.randomGenesRate << ',' << config.eliteSurvivalRate << ',' << CROSSOVER_NAMES[static_cast<int>(config.crossoverType)] << ','
+			<< result.bestFitness << ',' << result.finalFitness << ',' << result.isSolved << ',' << result.generations << ',' << result.generationOfBest << ','
+			<< result.timeToBestMs << ',' << result.runTimeMs << ',' << result.generationsPerSec << '\n';
+	}
+
+	return static_cast<bool>(file);
+}
+
+std::vector<SweepConfig> Sweep::sampleConfigs(const SweepSettings& settings) {
+	const std::array<const SweepRange*, 4> ranges = { &settings.populationSize, &settings.mutationRate, &settings.randomGenesRate, &settings.eliteSurvivalRate };
+	for (const auto* range : ranges) {
+		INPUT_VALIDITY(range->min >= 0 && range->min <= range->max);
+		INPUT_VALIDITY(range->steps > 0);
+	}
+	INPUT_VALIDITY(settings.populationSize.min > 0);
+	INPUT_VALIDITY(settings.mutationRate.max <= 100 && settings.randomGenesRate.max <= 100 && settings.eliteSurvivalRate.max <= 100);
+	INPUT_VALIDITY(settings.sampleAmount > 0);
+
+	std::vector<CrossoverType> crossoverTypes;
+	for (int i = 0; i < CROSSOVER_TYPE_AMOUNT; i++) {
+		if (settings.crossoverTypes[i]) {
+			crossoverTypes.emplace_back(static_cast<CrossoverType>(i));
+		}
+	}
+	if (crossoverTypes.empty()) {
+		crossoverTypes.emplace_back(CrossoverType::SinglePoint);
+	}
+	const SweepRange crossoverRange = { 0, static_cast<int>(crossoverTypes.size()) - 1, static_cast<int>(crossoverTypes.size()) };
+
+	std::vector<SweepConfig> result;
+	MyUtils::SplitMix64 rng(MyUtils::mixHash(settings.seed));
+
+	if (settings.sampling == SweepSampling::Grid) {
+		for (int populationSize : sampleGrid(settings.populationSize)) {
+			for (int mutationRate : sampleGrid(settings.mutationRate)) {
+				for (int randomGenesRate : sampleGrid(settings.randomGenesRate)) {
+					for (int eliteSurvivalRate : sampleGrid(settings.eliteSurvivalRate)) {
+						for (CrossoverType crossoverType : crossoverTypes) {
+							result.push_back({ populationSize, mutationRate, randomGenesRate, eliteSurvivalRate, crossoverType });
+						}
+					}
+				}
+			}
+		}
+	}
+	else if (settings.sampling == SweepSampling::Random) {
+		result.resize(settings.sampleAmount);
+		for (auto& config : result) {
+			config.populationSize    = sampleUniform(settings.populationSize, rng);
+			config.mutationRate      = sampleUniform(settings.mutationRate, rng);
+			config.randomGenesRate   = sampleUniform(settings.randomGenesRate, rng);
+			config.eliteSurvivalRate = sampleUniform(settings.eliteSurvivalRate, rng);
+			config.crossoverType     = crossoverTypes[sampleUniform(crossoverRange, rng)];
+		}
+	}
+	else {
+		std::vector<int> populationSizes    = sampleLatinHypercube(settings.populationSize, settings.sampleAmount, rng);
+		std::vector<int> mutationRates      = sampleLatinHypercube(settings.mutationRate, settings.sampleAmount, rng);
+		std::vector<int> randomGenesRates   = sampleLatinHypercube(settings.randomGenesRate, settings.sampleAmount, rng);
+		std::vector<int> eliteSurvivalRates = sampleLatinHypercube(settings.eliteSurvivalRate, settings.sampleAmount, rng);
+		std::vector<int> crossoverIndices   = sampleLatinHypercube(crossoverRange, settings.sampleAmount, rng);
+
+		result.resize(settings.sampleAmount);
+		for (size_t i = 0; i < result.size(); i++) {
+			result[i] = { populationSizes[i], mutationRates[i], randomGenesRates[i], eliteSurvivalRates[i], crossoverTypes[crossoverIndices[i]] };
+		}
+	}
+
+	OUTPUT_VALIDITY(!result.empty());
+
+	return result;
+}
+
+void Sweep::runJobs(size_t workerIndex, ThreadPlacement placement, std::stop_token stopToken) {
+	ScopedThreadPin threadPin(placement.getCpu(workerIndex));
+	Tracer::setThreadName("Sweep worker");
+	GenerationArena arena; // Allocated after pinning, so it lives on the worker's NUMA node
+
+	while (!stopToken.stop_requested()) {
+		size_t jobIndex = m_nextJob.fetch_add(1, std::memory_order_relaxed);
+		if (jobIndex >= m_results.size()) {
+			return;
+		}
+
+		size_t configIndex = jobIndex / m_seeds.size();
+		uint64_t seed = m_seeds[jobIndex % m_seeds.size()];
+
+		SweepRunResult result = m_jobFunc(m_configs[configIndex], seed, arena, stopToken);
+		if (stopToken.stop_requested()) {
+			return;
+		}
+
+		result.configIndex = static_cast<int>(configIndex);
+		result.seed = seed;
+		result.isDone = true;
+		m_results[jobIndex] = result;
+		m_doneAmount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Sweep::summarize() {
+	m_summaries.assign(m_configs.size(), SweepSummary{});
+	std::vector<double> totalRunTimesMs(m_configs.size());
+
+	for (const auto& result : m_results) {
+		if (!result.isDone) {
+			continue;
+		}
+
+		SweepSummary& summary = m_summaries[result.configIndex];
+		summary.avgBestFitness       += result.bestFitness;
+		summary.avgTimeToBestMs      += result.timeToBestMs;
+		summary.avgGenerationsPerSec += result.generationsPerSec;
+		summary.solvedAmount         += result.isSolved;
+		summary.runAmount++;
+		totalRunTimesMs[result.configIndex] += result.runTimeMs;
+	}
+
+	for (size_t i = 0; i < m_summaries.size(); i++) {
+		SweepSummary& summary = m_summaries[i];
+		summary.config = m_configs[i];
+		if (summary.runAmount > 0) {
+			summary.avgBestFitness       /= summary.runAmount;
+			summary.avgTimeToBestMs      /= summary.runAmount;
+			summary.avgGenerationsPerSec /= summary.runAmount;
+		}
+		summary.expectedRunTimeMs = summary.solvedAmount > 0 ? totalRunTimesMs[i] / summary.solvedAmount : std::numeric_limits<double>::infinity();
+	}
+
+	std::erase_if(m_summaries, [](const SweepSummary& summary) { return summary.runAmount == 0; });
+	std::ranges::sort(m_summaries, [](const SweepSummary& summary1, const SweepSummary& summary2) {
+		if (summary1.expectedRunTimeMs != summary2.expectedRunTimeMs) {
+			return summary1.expectedRunTimeMs < summary2.expectedRunTimeMs;
+		}
+		return summary1.avgBestFitness > summary2.avgBestFitness;
+	});
+}
+
+std::vector<int> Sweep::sampleGrid(const SweepRange& range) {
+	INPUT_VALIDITY(range.min <= range.max);
+	INPUT_VALIDITY(range.steps > 0);
+
+	std::vector<int> result;
+	if (range.steps == 1 || range.min == range.max) {
+		result.emplace_back(range.min);
+		return result;
+	}
+
+	for (int i = 0; i < range.steps; i++) {
+		int value = range.min + static_cast<int>(std::lround(static_cast<double>(range.max - range.min) * i / (range.steps - 1)));
+		if (result.empty() || result.back() != value) {
+			result.emplace_back(value);
+		}
+	}
+
+	OUTPUT_VALIDITY(result.front() == range.min && result.back() == range.max);
+
+	return result;
+}
+
+int Sweep::sampleUniform(const SweepRange& range, MyUtils::SplitMix64& rng) noexcept {
+	INPUT_VALIDITY(range.min <= range.max);
+
+	return range.min + static_cast<int>(rng() % (static_cast<uint64_t>(range.max - range.min) + 1));
+}
+
+std::vector<int> Sweep::sampleLatinHypercube(const SweepRange& range, int sampleAmount, MyUtils::SplitMix64& rng) {
+	INPUT_VALIDITY(range.min <= range.max);
+	INPUT_VALIDITY(sampleAmount > 0);
+
+	// One value from each of sampleAmount equal strata, in a random order per parameter
+	std::vector<int> result(sampleAmount);
+	double stratumWidth = static_cast<double>(range.max - range.min + 1) / sampleAmount;
+	for (int i = 0; i < sampleAmount; i++) {
+		double offset = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+		result[i] = std::min(range.max, range.min + static_cast<int>((i + offset) * stratumWidth));
+	}
+
+	for (size_t i = result.size() - 1; i > 0; i--) {
+		std::swap(result[i], result[rng() % (i + 1)]);
+	}
+
+	return result;
+}
@@ -0,0 +1,135 @@
+#include "ThreadPlacement.h"
+#include <sstream>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+ThreadPlacement::ThreadPlacement(std::vector<int> cpus)
+	: m_cpus(std::move(cpus)) {
+
+	for (int cpu : m_cpus) {
+		INPUT_VALIDITY(cpu >= 0 && cpu <= MAX_PINNED_CPU);
+	}
+}
+
+std::optional<ThreadPlacement> ThreadPlacement::parse(const std::string& cpuList) {
+	if (cpuList.empty() || cpuList == "none") {
+		return ThreadPlacement();
+	}
+
+	// Comma separated cores and inclusive ranges, like "0-3,8,10-11"
+	std::vector<int> cpus;
+	std::stringstream iss(cpuList);
+	std::string part;
+	while (std::getline(iss, part, ',')) {
+		size_t dashPos = part.find('-');
+		int first = -1;
+		int last = -1;
+		try {
+			size_t firstLength = 0;
+			first = std::stoi(part, &firstLength);
+			if (dashPos == std::string::npos) {
+				last = firstLength == part.size() ? first : -1;
+			}
+			else if (firstLength == dashPos) {
+				size_t lastLength = 0;
+				last = std::stoi(part.substr(dashPos + 1), &lastLength);
+				last = lastLength == part.size() - dashPos - 1 ? last : -1;
+			}
+		}
+		catch (const std::exception&) {
+			first = -1;
+		}
+
+		if (first < 0 || last < first || last > MAX_PINNED_CPU) {
+			std::cerr << "ThreadPlacement::parse: Invalid core \"" << part << "\" in \"" << cpuList << "\"\n";
+			return std::nullopt;
+		}
+		for (int cpu = first; cpu <= last; cpu++) {
+			cpus.emplace_back(cpu);
+		}
+	}
+
+	return ThreadPlacement(std::move(cpus));
+}
+
+bool ThreadPlacement::pinCurrentThread(int cpu) {
+	INPUT_VALIDITY(cpu >= 0 && cpu <= MAX_PINNED_CPU);
+
+#ifdef _WIN32
+	// Without processor groups a thread can only be pinned to the first 64 cores
+	if (cpu >= 64 || SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) == 0) {
+		std::cerr << "ThreadPlacement::pinCurrentThread: Cannot pin thread to core " << cpu << "\n";
+		return false;
+	}
+	return true;
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpu, &cpuSet);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+		std::cerr << "ThreadPlacement::pinCurrentThread: Cannot pin thread to core " << cpu << "\n";
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool ThreadPlacement::isEnabled() const noexcept {
+	return !m_cpus.empty();
+}
+
+size_t ThreadPlacement::getCpuAmount() const noexcept {
+	return m_cpus.size();
+}
+
+int ThreadPlacement::getCpu(size_t workerIndex) const noexcept {
+	if (m_cpus.empty()) {
+		return -1;
+	}
+
+	return m_cpus[workerIndex % m_cpus.size()];
+}
+
+ScopedThreadPin::ScopedThreadPin(int cpu) {
+	if (cpu < 0) {
+		return;
+	}
+
+#ifdef _WIN32
+	// SetThreadAffinityMask returns the previous mask, so it is pinned here instead of by pinCurrentThread
+	if (cpu < 64) {
+		m_previousMask = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+		m_isPinned = m_previousMask != 0;
+	}
+	if (!m_isPinned) {
+		std::cerr << "ScopedThreadPin::ScopedThreadPin: Cannot pin thread to core " << cpu << "\n";
+	}
+#elif defined(__linux__)
+	if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_previousMask) != 0) {
+		std::cerr << "ScopedThreadPin::ScopedThreadPin: Cannot read the cores of the thread, it is not pinned\n";
+		return;
+	}
+	m_isPinned = ThreadPlacement::pinCurrentThread(cpu);
+#endif
+}
+
+ScopedThreadPin::~ScopedThreadPin() {
+	if (!m_isPinned) {
+		return;
+	}
+
+#ifdef _WIN32
+	SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(m_previousMask));
+#elif defined(__linux__)
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_previousMask);
+#endif
+}
@@ -15,6 +15,14 @@ Timer::Timer(int msLimit) noexcept
 
 void Timer::start() noexcept {
 	m_startTime = Clock_t::now();
+	m_pauseTime = m_startTime;
+}
+
+void Timer::start(int msElapsed) noexcept {
+	INPUT_VALIDITY(msElapsed >= 0);
+
+	start();
+	m_startTime -= Milliseconds_t(msElapsed);
 }
 
 int Timer::getTimeLimit() const noexcept {
@@ -30,7 +38,11 @@ bool Timer::timeRanOut() const noexcept {
 }
 
 int Timer::timeElapsed() const noexcept {
-	return static_cast<int>(duration().count());
+	return static_cast<int>(std::chrono::duration_cast<Milliseconds_t>(duration()).count());
+}
+
+int64_t Timer::timeElapsedUs() const noexcept {
+	return static_cast<int64_t>(std::chrono::duration_cast<Microseconds_t>(duration()).count());
 }
 
 void Timer::setTimeLimit(int msLimit) noexcept {
@@ -41,7 +53,7 @@ void Timer::setTimeLimit(int msLimit) noexcept {
 
 void Timer::pause() noexcept {
 	if (m_isPaused) {
-		m_startTime += std::chrono::duration_cast<Milliseconds_t>(Clock_t::now() - m_pauseTime);
+		m_startTime += Clock_t::now() - m_pauseTime;
 	}
 	else {
 		m_pauseTime = Clock_t::now();
@@ -50,11 +62,11 @@ void Timer::pause() noexcept {
 	m_isPaused = !m_isPaused;
 }
 
-Timer::Milliseconds_t Timer::duration() const noexcept {
+Timer::Clock_t::duration Timer::duration() const noexcept {
 	if (m_isPaused) {
-		return std::chrono::duration_cast<Milliseconds_t>(m_pauseTime - m_startTime);
+		return m_pauseTime - m_startTime;
 	}
 	else {
-		return std::chrono::duration_cast<Milliseconds_t>(Clock_t::now() - m_startTime);
+		return Clock_t::now() - m_startTime;
 	}
 }
@@ -0,0 +1,140 @@
+#include "Tracer.h"
+#include <fstream>
+#include <chrono>
+
+
+void Tracer::start() {
+	// Buffers are emptied lazily by their owner on its next record(), so starting does not wait for the recording threads
+	s_epoch.fetch_add(1, std::memory_order_relaxed);
+	s_sessionStartUs.store(nowUs(), std::memory_order_relaxed);
+	s_isEnabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() noexcept {
+	s_isEnabled.store(false, std::memory_order_release);
+}
+
+bool Tracer::isEnabled() noexcept {
+	return s_isEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* name, int64_t beginUs, int64_t endUs) {
+	INPUT_VALIDITY(name != nullptr);
+	INPUT_VALIDITY(beginUs <= endUs);
+
+	ThreadBuffer& buffer = getThreadBuffer();
+	uint64_t epoch = s_epoch.load(std::memory_order_relaxed);
+	if (buffer.epoch.load(std::memory_order_relaxed) != epoch) {
+		// Events of an earlier trace are overwritten, so a long recording does not fill the buffer for later ones
+		buffer.size.store(0, std::memory_order_relaxed);
+		buffer.epoch.store(epoch, std::memory_order_release);
+	}
+
+	size_t index = buffer.size.load(std::memory_order_relaxed);
+	if (index >= TRACE_CHUNK_SIZE * TRACE_CHUNK_AMOUNT) {
+		return;
+	}
+
+	std::unique_ptr<Chunk>& chunk = buffer.chunks[index / TRACE_CHUNK_SIZE];
+	if (chunk == nullptr) {
+		chunk = std::make_unique<Chunk>();
+	}
+	chunk->events[index % TRACE_CHUNK_SIZE] = { name, beginUs, endUs - beginUs };
+
+	// Publishes the event and a freshly allocated chunk to writeJson
+	buffer.size.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+	INPUT_VALIDITY(name != nullptr);
+
+	if (isEnabled()) {
+		getThreadBuffer().threadName.store(name, std::memory_order_relaxed);
+	}
+}
+
+bool Tracer::writeJson(const std::string& path) {
+	INPUT_VALIDITY(!path.empty());
+
+	std::ofstream file(path, std::ios::trunc);
+	if (!file.is_open()) {
+		std::cerr << "Tracer::writeJson: Cannot open file with path \"" << path << "\"\n";
+		return false;
+	}
+
+	int64_t sessionStartUs = s_sessionStartUs.load(std::memory_order_relaxed);
+	uint64_t epoch = s_epoch.load(std::memory_order_relaxed);
+	bool isFirstEvent = true;
+	auto writeSeparator = [&]() {
+		file << (isFirstEvent ? "\n" : ",\n");
+		isFirstEvent = false;
+	};
+
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (const auto& buffer : s_buffers) {
+		const char* threadName = buffer->threadName.load(std::memory_order_relaxed);
+		writeSeparator();
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+			<< ",\"args\":{\"name\":\"" << (threadName != nullptr ? threadName : "Thread") << "\"}}";
+
+		// A thread that recorded nothing since start() still holds the events of an earlier trace
+		size_t size = buffer->epoch.load(std::memory_order_acquire) == epoch ? buffer->size.load(std::memory_order_acquire) : 0;
+		for (size_t i = 0; i < size; i++) {
+			const TraceEvent& event = buffer->chunks[i / TRACE_CHUNK_SIZE]->events[i % TRACE_CHUNK_SIZE];
+			if (event.beginUs < sessionStartUs) {
+				continue;
+			}
+
+			writeSeparator();
+			file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+				<< ",\"ts\":" << event.beginUs - sessionStartUs << ",\"dur\":" << event.durationUs << '}';
+		}
+	}
+	file << "\n]}\n";
+
+	return static_cast<bool>(file);
+}
+
+int64_t Tracer::nowUs() noexcept {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+	thread_local ThreadBufferLease lease;
+	return *lease.buffer;
+}
+
+Tracer::ThreadBufferLease::ThreadBufferLease() {
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+
+	// Threads that ran one after another, like the GA batch threads, end up sharing one buffer and one timeline track
+	if (!s_freeBuffers.empty()) {
+		buffer = s_freeBuffers.back();
+		s_freeBuffers.pop_back();
+		buffer->threadName.store(nullptr, std::memory_order_relaxed);
+		return;
+	}
+
+	buffer = s_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+	buffer->threadId = static_cast<int>(s_buffers.size());
+}
+
+Tracer::ThreadBufferLease::~ThreadBufferLease() {
+	std::lock_guard<std::mutex> lock(s_buffersMutex);
+	s_freeBuffers.emplace_back(buffer);
+}
+
+TraceScope::TraceScope(const char* name) noexcept
+	: m_name(name) {
+
+	if (Tracer::isEnabled()) {
+		m_beginUs = Tracer::nowUs();
+	}
+}
+
+TraceScope::~TraceScope() {
+	if (m_beginUs >= 0) {
+		Tracer::record(m_name, m_beginUs, Tracer::nowUs());
+	}
+}
@@ -0,0 +1,142 @@
+#include "WorkerPool.h"
+#include <algorithm>
+#include <utility>
+
+
+WorkerPool::WorkerPool(size_t threadAmount) {
+	startThreads(std::vector<int>(threadAmount, -1));
+}
+
+WorkerPool::~WorkerPool() {
+	stopThreads();
+}
+
+WorkerPool& WorkerPool::Instance() {
+	// The caller of run() is one of the threads, so the pool adds one thread less than there are cores
+	static WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+void WorkerPool::init(const ThreadPlacement& placement, size_t firstWorkerIndex) {
+	std::vector<int> cpus;
+	if (placement.isEnabled()) {
+		for (size_t i = firstWorkerIndex; i < placement.getCpuAmount(); i++) {
+			cpus.emplace_back(placement.getCpu(i));
+		}
+	}
+	else {
+		cpus.assign(std::max(1u, std::thread::hardware_concurrency()) - 1, -1);
+	}
+
+	// Waits for a running loop, later calls run inline on their caller until the new threads are up
+	std::lock_guard<std::mutex> runLock(m_runMutex);
+	stopThreads();
+	startThreads(cpus);
+}
+
+void WorkerPool::run(size_t taskAmount, const std::function<void(size_t)>& task) {
+	INPUT_VALIDITY(task != nullptr);
+
+	std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+	if (!runLock.owns_lock() || m_threads.empty() || taskAmount <= 1) {
+		for (size_t i = 0; i < taskAmount; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_taskAmount = taskAmount;
+		m_nextTask.store(0, std::memory_order_relaxed);
+		m_exception = nullptr;
+		m_runId++;
+	}
+	m_workCondition.notify_all();
+
+	runTasks(task, taskAmount);
+
+	std::exception_ptr exception;
+	{
+		// Every task is claimed by now, so once no worker is busy every task has finished. Clearing the task under
+		// the lock keeps a worker that wakes up late from calling it.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneCondition.wait(lock, [this]() { return m_busyWorkerAmount == 0; });
+		m_task = nullptr;
+		m_taskAmount = 0;
+		exception = std::exchange(m_exception, nullptr);
+	}
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+size_t WorkerPool::getThreadAmount() const noexcept {
+	return m_threads.size();
+}
+
+void WorkerPool::startThreads(const std::vector<int>& cpus) {
+	m_threads.reserve(cpus.size());
+	for (int cpu : cpus) {
+		m_threads.emplace_back([this, cpu](std::stop_token stopToken) {
+			// Pinned once for the life of the thread, so every loop on it stays on its core
+			if (cpu >= 0) {
+				ThreadPlacement::pinCurrentThread(cpu);
+			}
+			work(stopToken);
+		});
+	}
+}
+
+void WorkerPool::stopThreads() noexcept {
+	for (auto& thread : m_threads) {
+		thread.request_stop();
+	}
+	m_threads.clear();
+}
+
+void WorkerPool::work(std::stop_token stopToken) {
+	uint64_t seenRunId = 0;
+
+	while (true) {
+		const std::function<void(size_t)>* task = nullptr;
+		size_t taskAmount = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (!m_workCondition.wait(lock, stopToken, [this, seenRunId]() { return m_runId != seenRunId; })) {
+				return;
+			}
+			seenRunId = m_runId;
+			if (m_task == nullptr) {
+				continue;
+			}
+			task = m_task;
+			taskAmount = m_taskAmount;
+			m_busyWorkerAmount++;
+		}
+
+		runTasks(*task, taskAmount);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_busyWorkerAmount--;
+		}
+		m_doneCondition.notify_one();
+	}
+}
+
+void WorkerPool::runTasks(const std::function<void(size_t)>& task, size_t taskAmount) {
+	for (size_t i = m_nextTask.fetch_add(1, std::memory_order_relaxed); i < taskAmount; i = m_nextTask.fetch_add(1, std::memory_order_relaxed)) {
+		try {
+			task(i);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception) {
+				m_exception = std::current_exception();
+			}
+		}
+	}
+}
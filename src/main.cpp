@@ -1,7 +1,22 @@
 #include "GameEngine.h"
 
-int main() {
-    GameEngine game("resources/config.txt");
+int main(int argc, char* argv[]) {
+    // "--Type values..." overrides the config line of that type, for example --Affinity 0-3 --Seed 42
+    std::vector<std::string> configOverrides;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.starts_with("--") && arg.size() > 2) {
+            configOverrides.emplace_back(arg.substr(2));
+        }
+        else if (!configOverrides.empty()) {
+            configOverrides.back() += " " + arg;
+        }
+        else {
+            std::cerr << "main: Ignoring argument \"" << arg << "\"\n";
+        }
+    }
+
+    GameEngine game("resources/config.txt", std::move(configOverrides));
     game.run();
 
     return EXIT_SUCCESS;